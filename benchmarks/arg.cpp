@@ -0,0 +1,58 @@
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <router/router.hpp>
+
+namespace {
+
+std::vector<std::string> make_tokens(std::size_t digits, bool valid) {
+    std::mt19937_64 random(digits);
+    std::vector<std::string> result;
+    for (std::size_t i = 0; i < 1024; ++i) {
+        std::string token;
+        for (std::size_t j = 0; j < digits; ++j) {
+            token += char('0' + random() % 10);
+        }
+        if (!valid) {
+            token[random() % digits] = 'x';
+        }
+        result.push_back(std::move(token));
+    }
+    return result;
+}
+
+std::optional<std::uint64_t> from_chars(std::string_view token) {
+    std::uint64_t result = 0;
+    const auto [end, error] = std::from_chars(token.data(), token.data() + token.size(), result);
+    if (error != std::errc() || end != token.data() + token.size()) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+template <auto parse>
+void convert(benchmark::State& state) {
+    const std::vector<std::string> tokens = make_tokens(static_cast<std::size_t>(state.range(0)), state.range(1) != 0);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(parse(tokens[i++ % 1024]));
+    }
+}
+
+constexpr auto parse_integer = [] (std::string_view token) {
+    return router::parse_integer<router::arg::u64>(token);
+};
+
+} // namespace
+
+BENCHMARK(convert<from_chars>)->ArgsProduct({{3, 8, 12, 19}, {1, 0}});
+BENCHMARK(convert<parse_integer>)->ArgsProduct({{3, 8, 12, 19}, {1, 0}});
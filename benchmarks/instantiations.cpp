@@ -0,0 +1,55 @@
+#include <array>
+#include <cstddef>
+#include <list>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <router/router.hpp>
+
+namespace {
+
+constexpr std::array<std::string_view, 16> verbs {
+    "get", "put", "post", "delete", "head", "options", "patch", "trace",
+    "add", "remove", "list", "show", "cast", "learn", "channel", "mana",
+};
+
+template <std::size_t i>
+struct Verb {
+    using value_type = std::string_view;
+
+    static constexpr std::string_view value = verbs[i];
+};
+
+template <std::size_t i>
+struct Leaf {
+    std::size_t operator ()(std::string_view first, std::string_view second, std::string_view third) const {
+        return i + first.size() + second.size() + third.size();
+    }
+};
+
+template <std::size_t group, std::size_t ... i>
+auto make_group(std::index_sequence<i ...>) {
+    return router::Selector(router::Action(Verb<i>(), Leaf<group * verbs.size() + i>()) ...);
+}
+
+template <std::size_t ... group>
+auto make_tree(std::index_sequence<group ...>) {
+    return router::Selector(
+        router::Action(Verb<group>(), make_group<group>(std::make_index_sequence<verbs.size()>())) ...
+    );
+}
+
+const auto tree = make_tree(std::make_index_sequence<8>());
+
+} // namespace
+
+std::size_t dispatch(const std::vector<std::string>& request) {
+    return tree(std::views::all(request)).value_or(0);
+}
+
+std::size_t dispatch(const std::list<std::string>& request) {
+    return tree(std::views::all(request)).value_or(0);
+}
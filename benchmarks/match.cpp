@@ -0,0 +1,104 @@
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <router/match.hpp>
+
+namespace {
+
+constexpr std::array<std::string_view, 48> verbs {
+    "get", "put", "post", "delete", "head", "options", "patch", "trace",
+    "add", "remove", "list", "show", "cast", "learn", "channel", "mana",
+    "cost", "spells", "wizards", "rooms", "talks", "speakers", "conferences", "roll_dice",
+    "create", "update", "upsert", "find", "search", "count", "exists", "watch",
+    "lock", "unlock", "ping", "stats", "config", "reload", "shutdown", "status",
+    "begin", "commit", "rollback", "subscribe", "unsubscribe", "publish", "flush", "compact",
+};
+
+template <std::size_t i>
+struct Verb {
+    static constexpr std::string_view name = verbs[i];
+};
+
+template <class Sequence>
+struct VerbNames;
+
+template <std::size_t ... i>
+struct VerbNames<std::index_sequence<i ...>> {
+    using type = router::Names<Verb<i> ...>;
+};
+
+template <class Names>
+using PrefilterLinearMatch = router::PrefilterMatch<Names, router::LinearMatch<Names>>;
+
+template <std::size_t n>
+using verb_names_t = typename VerbNames<std::make_index_sequence<n>>::type;
+
+enum class Traffic {
+    Hit,
+    Miss,
+    Hot,
+    Garbage,
+};
+
+std::vector<std::string> make_tokens(std::size_t n, Traffic traffic) {
+    std::vector<std::string> result;
+    for (std::size_t i = 0; i < n; ++i) {
+        switch (traffic) {
+            case Traffic::Hit:
+                result.emplace_back(verbs[(i * 7) % n]);
+                break;
+            case Traffic::Miss:
+                result.emplace_back(verbs[(i * 7) % n]);
+                result.back().back() = '#';
+                break;
+            case Traffic::Hot:
+                result.emplace_back(verbs[i % 8 == 0 ? i : n - 1 - i % 2]);
+                break;
+            case Traffic::Garbage:
+                result.emplace_back(std::string(i % 5 + 1, char('0' + i % 10)) + "?");
+                break;
+        }
+    }
+    return result;
+}
+
+template <template <class> class Match, std::size_t n, Traffic traffic>
+void find(benchmark::State& state) {
+    using match = Match<verb_names_t<n>>;
+    const std::vector<std::string> tokens = make_tokens(n, traffic);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(match::find(std::string_view(tokens[i])));
+        i = i + 1 == tokens.size() ? 0 : i + 1;
+    }
+}
+
+template <template <class> class Match>
+void register_match(const char* name) {
+    benchmark::RegisterBenchmark((std::string(name) + "/8/hit").c_str(), find<Match, 8, Traffic::Hit>);
+    benchmark::RegisterBenchmark((std::string(name) + "/8/miss").c_str(), find<Match, 8, Traffic::Miss>);
+    benchmark::RegisterBenchmark((std::string(name) + "/48/hit").c_str(), find<Match, 48, Traffic::Hit>);
+    benchmark::RegisterBenchmark((std::string(name) + "/48/miss").c_str(), find<Match, 48, Traffic::Miss>);
+    benchmark::RegisterBenchmark((std::string(name) + "/48/hot").c_str(), find<Match, 48, Traffic::Hot>);
+    benchmark::RegisterBenchmark((std::string(name) + "/48/garbage").c_str(), find<Match, 48, Traffic::Garbage>);
+}
+
+const bool registered = [] {
+    register_match<router::LinearMatch>("LinearMatch");
+    register_match<PrefilterLinearMatch>("PrefilterLinearMatch");
+    register_match<router::VectorMatch>("VectorMatch");
+    register_match<router::PerfectHashMatch>("PerfectHashMatch");
+    register_match<router::DecisionTreeMatch>("DecisionTreeMatch");
+    register_match<router::AdaptiveMatch>("AdaptiveMatch");
+    register_match<router::AutoMatch>("AutoMatch");
+    register_match<router::PrefilterAutoMatch>("PrefilterAutoMatch");
+    return true;
+} ();
+
+} // namespace
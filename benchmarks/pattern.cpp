@@ -0,0 +1,52 @@
+#include <cstddef>
+#include <random>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <router/pattern.hpp>
+
+namespace {
+
+std::vector<std::string> make_tokens(bool valid) {
+    std::mt19937_64 random(valid);
+    std::vector<std::string> result;
+    for (std::size_t i = 0; i < 1024; ++i) {
+        std::string token = "v";
+        for (std::size_t j = 0, size = 1 + random() % 4; j < size; ++j) {
+            token += char('0' + random() % 10);
+        }
+        if (!valid) {
+            token[random() % token.size()] = 'x';
+        }
+        result.push_back(std::move(token));
+    }
+    return result;
+}
+
+constexpr auto version = router::regex("v[0-9]+");
+
+void dfa(benchmark::State& state) {
+    const std::vector<std::string> tokens = make_tokens(state.range(0) != 0);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(version.matches(tokens[i++ % 1024]));
+    }
+}
+
+void std_regex(benchmark::State& state) {
+    const std::vector<std::string> tokens = make_tokens(state.range(0) != 0);
+    const std::regex pattern("v[0-9]+");
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::regex_match(tokens[i++ % 1024], pattern));
+    }
+}
+
+} // namespace
+
+BENCHMARK(dfa)->Arg(1)->Arg(0);
+BENCHMARK(std_regex)->Arg(1)->Arg(0);
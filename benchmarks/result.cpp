@@ -0,0 +1,98 @@
+#include <array>
+#include <cstddef>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <router/arg.hpp>
+
+namespace {
+
+constexpr std::array<std::string_view, 8> verbs {
+    "get", "put", "post", "delete", "head", "options", "patch", "trace",
+};
+
+template <std::size_t i>
+struct Verb {
+    using value_type = std::string_view;
+
+    static constexpr std::string_view value = verbs[i];
+};
+
+template <std::size_t i>
+struct Leaf {
+    std::size_t operator ()(std::size_t id) const noexcept {
+        return i + id;
+    }
+};
+
+struct Expected : router::DefaultPolicy {
+    using result = router::ExpectedResult;
+};
+
+#ifdef __cpp_lib_expected
+struct StdExpected : router::DefaultPolicy {
+    using result = router::StdExpectedResult;
+};
+#endif
+
+struct Throwing : router::DefaultPolicy {
+    using result = router::ThrowingResult;
+};
+
+template <class Policy, std::size_t ... i>
+auto make_tree(std::index_sequence<i ...>) {
+    return router::selector<Policy>(router::Action(Verb<i>(), Leaf<i>()) ...);
+}
+
+template <class Policy>
+const auto tree = make_tree<Policy>(std::make_index_sequence<verbs.size()>());
+
+std::vector<std::vector<std::string_view>> make_requests(bool valid) {
+    static const std::array<std::string, 4> ids {"1", "42", "1337", "65535"};
+    std::vector<std::vector<std::string_view>> result;
+    for (std::size_t i = 0; i < 1024; ++i) {
+        result.push_back({valid ? verbs[i % verbs.size()] : "link", ids[i % ids.size()]});
+    }
+    return result;
+}
+
+template <class Value>
+std::size_t value_of(const Value& value) {
+    if constexpr (std::is_same_v<Value, std::size_t>) {
+        return value;
+    } else {
+        return value ? *value : 0;
+    }
+}
+
+template <class Policy>
+void dispatch(benchmark::State& state) {
+    const auto requests = make_requests(state.range(0) != 0);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const auto& request = requests[i++ % requests.size()];
+        if constexpr (std::is_same_v<Policy, Throwing>) {
+            try {
+                benchmark::DoNotOptimize(value_of(tree<Policy>(std::views::all(request))));
+            } catch (const router::Exception& e) {
+                benchmark::DoNotOptimize(e.error);
+            }
+        } else {
+            benchmark::DoNotOptimize(value_of(tree<Policy>(std::views::all(request))));
+        }
+    }
+}
+
+} // namespace
+
+BENCHMARK(dispatch<Expected>)->Arg(1)->Arg(0);
+#ifdef __cpp_lib_expected
+BENCHMARK(dispatch<StdExpected>)->Arg(1)->Arg(0);
+#endif
+BENCHMARK(dispatch<Throwing>)->Arg(1)->Arg(0);
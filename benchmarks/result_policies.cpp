@@ -0,0 +1,59 @@
+#include <array>
+#include <cstddef>
+#include <ranges>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <router/arg.hpp>
+
+namespace {
+
+constexpr std::array<std::string_view, 8> verbs {
+    "get", "put", "post", "delete", "head", "options", "patch", "trace",
+};
+
+template <std::size_t i>
+struct Verb {
+    using value_type = std::string_view;
+
+    static constexpr std::string_view value = verbs[i];
+};
+
+template <std::size_t i>
+struct Leaf {
+    std::size_t operator ()(std::size_t id) const noexcept {
+        return i + id;
+    }
+};
+
+template <class Result>
+struct Policy : router::DefaultPolicy {
+    using result = Result;
+};
+
+template <class Result, std::size_t ... i>
+auto make_tree(std::index_sequence<i ...>) {
+    return router::selector<Policy<Result>>(router::Action(Verb<i>(), Leaf<i>()) ...);
+}
+
+template <class Result>
+const auto tree = make_tree<Result>(std::make_index_sequence<verbs.size()>());
+
+} // namespace
+
+router::Result<std::size_t> dispatch_expected(const std::vector<std::string_view>& request) {
+    return tree<router::ExpectedResult>(std::views::all(request));
+}
+
+#ifdef __cpp_lib_expected
+std::expected<std::size_t, router::Error> dispatch_std_expected(const std::vector<std::string_view>& request) {
+    return tree<router::StdExpectedResult>(std::views::all(request));
+}
+#endif
+
+#ifdef __cpp_exceptions
+std::size_t dispatch_throwing(const std::vector<std::string_view>& request) {
+    return tree<router::ThrowingResult>(std::views::all(request));
+}
+#endif
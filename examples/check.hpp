@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+#include <source_location>
+#include <string_view>
+
+#include <router/router.hpp>
+
+namespace expect {
+
+template <class Result, class T>
+bool value(const Result& result, const T& expected, std::source_location where = std::source_location::current()) {
+    if (!result || !(*result == expected)) {
+        std::cout << where.file_name() << ":" << where.line() << ": unexpected result" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+template <class Result>
+bool error(const Result& result, router::Errc code, std::size_t index,
+           std::source_location where = std::source_location::current()) {
+    if (result || result.error().code != code || result.error().index != index) {
+        std::cout << where.file_name() << ":" << where.line() << ": unexpected error" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace expect
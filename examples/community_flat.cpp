@@ -0,0 +1,18 @@
+#include <ranges>
+
+#include <router/flat.hpp>
+
+#include "community.hpp"
+
+namespace {
+
+constexpr auto routes = router::flatten(conference::routes);
+
+} // namespace
+
+int main() {
+    return conference::run([] (conference::Community& community, const conference::Request& request) {
+        return routes(std::ranges::subrange(begin(request), end(request)), community)
+            .map(conference::Serialize {});
+    });
+}
@@ -0,0 +1,10 @@
+#include <ranges>
+
+#include "community.hpp"
+
+int main() {
+    return conference::run([] (conference::Community& community, const conference::Request& request) {
+        return conference::routes(router::tokens(std::ranges::subrange(begin(request), end(request))), community)
+            .map(conference::Serialize {});
+    });
+}
@@ -0,0 +1,147 @@
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <router/flat.hpp>
+
+#include "check.hpp"
+
+namespace {
+
+using router::Action;
+using router::Errc;
+using router::Result;
+using router::Selector;
+using router::argument;
+
+constexpr struct ListTag {
+    using value_type = std::string_view;
+
+    static constexpr std::string_view value = "list";
+} list_tag;
+
+constexpr struct SumTag {
+    using value_type = std::string_view;
+
+    static constexpr std::string_view value = "sum";
+} sum_tag;
+
+constexpr struct FindTag {
+    using value_type = std::string_view;
+
+    static constexpr std::string_view value = "find";
+} find_tag;
+
+constexpr struct ItemTag {
+    using value_type = std::string_view;
+
+    static constexpr std::string_view value = "item";
+} item_tag;
+
+constexpr struct GetTag {
+    using value_type = std::string_view;
+
+    static constexpr std::string_view value = "get";
+} get_tag;
+
+struct Items {
+    static inline int copies = 0;
+
+    std::vector<int> values;
+
+    explicit Items(std::vector<int> values) : values(std::move(values)) {}
+
+    Items(const Items& other) : values(other.values) {
+        ++copies;
+    }
+
+    Items(Items&&) = default;
+};
+
+struct Store {
+    int base = 0;
+    int calls = 0;
+};
+
+struct Serialize {
+    std::string output;
+
+    void operator ()(const Items& items) {
+        output = "items " + std::to_string(items.values.size());
+    }
+
+    void operator ()(int value) {
+        output = "int " + std::to_string(value);
+    }
+
+    void operator ()(const std::string& value) {
+        output = "string " + value;
+    }
+};
+
+constexpr Selector routes(
+    Action(list_tag, [] (Store& store, int size) { ++store.calls; return Items(std::vector<int>(size, store.base)); }),
+    Action(sum_tag, [] (Store& store, int lhs, int rhs) { ++store.calls; return lhs + rhs; }),
+    Action(find_tag, [] (Store& store, int id) -> Result<std::string> {
+        ++store.calls;
+        if (id < 0) {
+            return tl::make_unexpected(Errc::NotFound);
+        }
+        return std::to_string(id);
+    }),
+    Action(item_tag, argument<int>(
+        Action(get_tag, [] (Store& store, int id) { ++store.calls; return store.base + id; })
+    ))
+);
+
+template <class Node>
+Result<std::string> serialized(const Node& node, const std::vector<std::string_view>& input) {
+    Store store {100};
+    Serialize serialize;
+    const Result<void> result = node.dispatch(std::views::all(input), store, serialize);
+    if (!result && serialize.output.empty()) {
+        return tl::make_unexpected(result.error());
+    }
+    if (store.calls != 1) {
+        return "calls " + std::to_string(store.calls);
+    }
+    return serialize.output;
+}
+
+template <class Node>
+bool check(const Node& node) {
+    Items::copies = 0;
+    return expect::value(serialized(node, {"list", "3"}), "items 3")
+        && Items::copies == 0
+        && expect::value(serialized(node, {"sum", "1", "2"}), "int 3")
+        && expect::value(serialized(node, {"find", "7"}), "string 7")
+        && expect::value(serialized(node, {"item", "5", "get"}), "int 105")
+        && expect::error(serialized(node, {"find", "-7"}), Errc::NotFound, 1)
+        && expect::error(serialized(node, {"item", "x", "get"}), Errc::InvalidArgument, 1)
+        && expect::error(serialized(node, {"sum", "1", "2", "3"}), Errc::TooManyArguments, 3)
+        && expect::error(serialized(node, {"item", "5"}), Errc::NotEnoughInput, 2)
+        && expect::error(serialized(node, {"remove"}), Errc::InvalidAction, 0);
+}
+
+} // namespace
+
+int main() {
+    if (!check(routes)) {
+        return -1;
+    }
+    if (!check(router::flatten(routes))) {
+        return -1;
+    }
+    const std::vector<std::string_view> input {"sum", "20", "22"};
+    Store store;
+    const Result<std::size_t> size = routes.dispatch(std::views::all(input), store, [] (const auto& value) {
+        return sizeof(value);
+    });
+    if (!size || *size != sizeof(int)) {
+        return -1;
+    }
+    std::cout << "continuation ok" << std::endl;
+    return 0;
+}
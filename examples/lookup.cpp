@@ -0,0 +1,101 @@
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <router/flat.hpp>
+
+#include "check.hpp"
+
+namespace {
+
+using router::Action;
+using router::Errc;
+using router::Result;
+using router::Selector;
+using router::argument;
+
+constexpr struct WizardsTag {
+    using value_type = std::string_view;
+
+    static constexpr std::string_view value = "wizards";
+} wizards_tag;
+
+constexpr struct GetTag {
+    using value_type = std::string_view;
+
+    static constexpr std::string_view value = "get";
+} get_tag;
+
+constexpr struct HealTag {
+    using value_type = std::string_view;
+
+    static constexpr std::string_view value = "heal";
+} heal_tag;
+
+struct Wizard {
+    int health = 0;
+};
+
+struct State {
+    std::map<std::string, Wizard, std::less<>> wizards;
+    int lookups = 0;
+};
+
+struct WizardRef {
+    std::map<std::string, Wizard, std::less<>>::iterator value;
+};
+
+} // namespace
+
+template <>
+struct router::Parser<WizardRef> {
+    static Result<WizardRef> parse(std::string_view name, State& state) {
+        ++state.lookups;
+        const auto found = state.wizards.find(name);
+        if (found == state.wizards.end()) {
+            return tl::make_unexpected(Errc::NotFound);
+        }
+        return WizardRef {found};
+    }
+};
+
+namespace {
+
+constexpr Selector routes(
+    Action(wizards_tag, argument<WizardRef>(
+        Action(get_tag, [] (State&, WizardRef wizard) { return wizard.value->second.health; }),
+        Action(heal_tag, [] (State&, WizardRef wizard, int amount) { return wizard.value->second.health += amount; })
+    ))
+);
+
+template <class Node>
+bool check(const Node& node) {
+    State state {{{"merlin", Wizard {10}}, {"morgana", Wizard {20}}}};
+    const std::vector<std::string_view> get {"wizards", "morgana", "get"};
+    const std::vector<std::string_view> heal {"wizards", "merlin", "heal", "5"};
+    const std::vector<std::string_view> healed {"wizards", "merlin", "get"};
+    const std::vector<std::string_view> missing {"wizards", "gandalf", "get"};
+    const std::vector<std::string_view> invalid {"wizards", "merlin", "cast"};
+    const std::vector<std::string_view> short_input {"wizards", "merlin", "heal"};
+    return expect::value(node(std::views::all(get), state), 20)
+        && expect::value(node(std::views::all(heal), state), 15)
+        && expect::value(node(std::views::all(healed), state), 15)
+        && expect::error(node(std::views::all(missing), state), Errc::NotFound, 1)
+        && state.lookups == 4
+        && expect::error(node(std::views::all(invalid), state), Errc::InvalidAction, 2)
+        && expect::error(node(std::views::all(short_input), state), Errc::NotEnoughInput, 3)
+        && state.lookups == 4;
+}
+
+} // namespace
+
+int main() {
+    if (!check(routes) || !check(router::flatten(routes))) {
+        return -1;
+    }
+    std::cout << "lookup ok" << std::endl;
+    return 0;
+}
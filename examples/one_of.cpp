@@ -0,0 +1,162 @@
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include <router/arg.hpp>
+#include <router/flat.hpp>
+
+#include "check.hpp"
+
+namespace {
+
+using router::Action;
+using router::Errc;
+using router::Selector;
+using router::TokenClass;
+using router::argument;
+using router::charset;
+using router::constrained;
+using router::in_range;
+using router::max_length;
+using router::one_of;
+
+constexpr struct UsersTag {
+    using value_type = std::string_view;
+
+    static constexpr std::string_view value = "users";
+} users_tag;
+
+constexpr struct PagesTag {
+    using value_type = std::string_view;
+
+    static constexpr std::string_view value = "pages";
+} pages_tag;
+
+constexpr struct GetTag {
+    using value_type = std::string_view;
+
+    static constexpr std::string_view value = "get";
+} get_tag;
+
+using Slug = constrained<std::string_view, charset<TokenClass::Identifier>, max_length<8>>;
+
+using Page = constrained<int, in_range<1, 100>>;
+
+std::string describe(one_of<unsigned, Slug> user) {
+    if (const auto id = std::get_if<unsigned>(&user)) {
+        return "user id " + std::to_string(*id);
+    }
+    return "user slug " + std::string(std::get<Slug>(user).value);
+}
+
+constexpr Selector routes(
+    Action(users_tag, Selector(
+        argument<unsigned>(Action(get_tag, [] (unsigned id) { return "id " + std::to_string(id); })),
+        argument<Slug>(Action(get_tag, [] (Slug slug) { return "slug " + std::string(slug.value); }))
+    )),
+    Action(pages_tag, [] (Page page, one_of<unsigned, Slug> user) {
+        return "page " + std::to_string(page.value) + " of " + describe(user);
+    })
+);
+
+constexpr Selector trailing(
+    argument<int>(Action(get_tag, [] (int value) { return "value " + std::to_string(value); })),
+    Action(pages_tag, [] { return std::string("pages"); })
+);
+
+constexpr Selector branches(
+    argument<unsigned>(Action(get_tag, [] (unsigned id) { return "id " + std::to_string(id); })),
+    argument<Slug>(Action(get_tag, [] (Slug slug) { return "slug " + std::string(slug.value); })),
+    Action(pages_tag, [] { return std::string("pages"); })
+);
+
+constexpr auto prefiltered = router::selector<router::PrefilterPolicy>(
+    Action(users_tag, [] (unsigned id) { return "user " + std::to_string(id); }),
+    argument<unsigned>(Action(get_tag, [] (unsigned id) { return "id " + std::to_string(id); })),
+    argument<Slug>(Action(get_tag, [] (Slug slug) { return "slug " + std::string(slug.value); }))
+);
+
+static_assert(decltype(trailing)::branches == 1);
+static_assert(decltype(branches)::branches == 2);
+
+template <class Node>
+bool check_routes(const Node& node) {
+    const std::vector<std::string_view> id {"users", "42", "get"};
+    const std::vector<std::string_view> slug {"users", "alice", "get"};
+    const std::vector<std::string_view> padded {"users", "007", "get"};
+    const std::vector<std::string_view> page_id {"pages", "3", "42"};
+    const std::vector<std::string_view> page_slug {"pages", "100", "bob"};
+    const std::vector<std::string_view> dashed {"users", "a-b", "get"};
+    const std::vector<std::string_view> long_slug {"users", "verylongname", "get"};
+    const std::vector<std::string_view> page_zero {"pages", "0", "bob"};
+    const std::vector<std::string_view> negative {"pages", "1", "-5"};
+    const std::vector<std::string_view> blank {"pages", "1", ""};
+    return expect::value(node(std::views::all(id)), "id 42")
+        && expect::value(node(std::views::all(slug)), "slug alice")
+        && expect::value(node(std::views::all(padded)), "id 7")
+        && expect::value(node(std::views::all(page_id)), "page 3 of user id 42")
+        && expect::value(node(std::views::all(page_slug)), "page 100 of user slug bob")
+        && expect::error(node(std::views::all(dashed)), Errc::InvalidArgument, 1)
+        && expect::error(node(std::views::all(long_slug)), Errc::InvalidArgument, 1)
+        && expect::error(node(std::views::all(page_zero)), Errc::InvalidArgument, 1)
+        && expect::error(node(std::views::all(negative)), Errc::InvalidArgument, 2)
+        && expect::error(node(std::views::all(blank)), Errc::InvalidArgument, 2);
+}
+
+template <class Node>
+bool check_trailing(const Node& node) {
+    const std::vector<std::string_view> value {"5", "get"};
+    const std::vector<std::string_view> word {"xyz", "get"};
+    const std::vector<std::string_view> name {"pages", "get"};
+    return expect::value(node(std::views::all(value)), "value 5")
+        && expect::error(node(std::views::all(word)), Errc::InvalidArgument, 0)
+        && expect::error(node(std::views::all(name)), Errc::InvalidArgument, 0);
+}
+
+template <class Node>
+bool check_branches(const Node& node) {
+    const std::vector<std::string_view> id {"7", "get"};
+    const std::vector<std::string_view> slug {"bob", "get"};
+    const std::vector<std::string_view> name {"pages", "get"};
+    const std::vector<std::string_view> dashed {"a-b", "get"};
+    return expect::value(node(std::views::all(id)), "id 7")
+        && expect::value(node(std::views::all(slug)), "slug bob")
+        && expect::value(node(std::views::all(name)), "slug pages")
+        && expect::error(node(std::views::all(dashed)), Errc::InvalidArgument, 0);
+}
+
+template <class Node>
+bool check_prefiltered(const Node& node) {
+    const std::vector<std::string_view> user {"users", "7"};
+    const std::vector<std::string_view> id {"42", "get"};
+    const std::vector<std::string_view> slug {"usersx", "get"};
+    const std::vector<std::string_view> dashed {"a-b", "get"};
+    return expect::value(node(std::views::all(user)), "user 7")
+        && expect::value(node(std::views::all(id)), "id 42")
+        && expect::value(node(std::views::all(slug)), "slug usersx")
+        && expect::error(node(std::views::all(dashed)), Errc::InvalidArgument, 0);
+}
+
+} // namespace
+
+int main() {
+    static_assert(router::classify("42") == (TokenClass::Any | TokenClass::Digits | TokenClass::Number | TokenClass::Hex));
+    static_assert((router::classify("-42") & TokenClass::Digits) == TokenClass::None);
+    static_assert(router::classify("") == TokenClass::Any);
+    if (!check_routes(routes) || !check_routes(router::flatten(routes))) {
+        return -1;
+    }
+    if (!check_trailing(trailing) || !check_trailing(router::flatten(trailing))) {
+        return -1;
+    }
+    if (!check_branches(branches) || !check_branches(router::flatten(branches))) {
+        return -1;
+    }
+    if (!check_prefiltered(prefiltered) || !check_prefiltered(router::flatten(prefiltered))) {
+        return -1;
+    }
+    std::cout << "one_of ok" << std::endl;
+    return 0;
+}
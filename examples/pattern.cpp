@@ -0,0 +1,113 @@
+#include <iostream>
+#include <list>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <router/flat.hpp>
+#include <router/pattern.hpp>
+
+#include "check.hpp"
+
+namespace {
+
+using router::Action;
+using router::Errc;
+using router::Selector;
+
+constexpr struct LatestTag {
+    using value_type = std::string_view;
+
+    static constexpr std::string_view value = "v0";
+} latest_tag;
+
+struct VersionTag {
+    static constexpr router::Pattern value = router::regex("v[0-9]+");
+
+    using value_type = std::remove_const_t<decltype(value)>;
+};
+
+struct DocumentTag {
+    static constexpr router::Pattern value = router::glob("*.json");
+
+    using value_type = std::remove_const_t<decltype(value)>;
+};
+
+struct NameTag {
+    static constexpr router::Pattern value = router::regex("[a-z_][a-z0-9_]*");
+
+    using value_type = std::remove_const_t<decltype(value)>;
+};
+
+static_assert(router::regex("colou?r").matches("color") && router::regex("colou?r").matches("colour"));
+static_assert(router::regex("[^a-c]x*").matches("d") && !router::regex("[^a-c]x*").matches("bx"));
+static_assert(router::regex("a\\.b").matches("a.b") && !router::regex("a\\.b").matches("axb"));
+static_assert(router::glob("a?c").matches("abc") && !router::glob("a?c").matches("ac"));
+static_assert(router::glob("*").matches("") && !router::regex("[0-9]+").matches(""));
+
+template <class Source, bool = (router::parse_regex<16>(Source {}()), true)>
+constexpr bool valid_regex(Source) {
+    return true;
+}
+
+constexpr bool valid_regex(...) {
+    return false;
+}
+
+template <class Source, bool = (router::parse_glob<16>(Source {}()), true)>
+constexpr bool valid_glob(Source) {
+    return true;
+}
+
+constexpr bool valid_glob(...) {
+    return false;
+}
+
+static_assert(valid_regex([] { return std::string_view("a\\.b[\\-_]"); }));
+static_assert(!valid_regex([] { return std::string_view("\\d+"); }));
+static_assert(!valid_regex([] { return std::string_view("[\\w-]"); }));
+static_assert(!valid_regex([] { return std::string_view("a\\sb"); }));
+static_assert(!valid_regex([] { return std::string_view("(a|b)"); }));
+static_assert(!valid_glob([] { return std::string_view("\\d*"); }));
+
+constexpr Selector routes(
+    Action(latest_tag, [] (std::string_view id) { return "latest " + std::string(id); }),
+    Action(VersionTag {}, [] (std::string_view id) { return "versioned " + std::string(id); }),
+    Action(DocumentTag {}, [] (std::string_view id) { return "document " + std::string(id); }),
+    Action(NameTag {}, [] (std::string_view id) { return "name " + std::string(id); })
+);
+
+template <class Node>
+bool check(const Node& node) {
+    const std::vector<std::string_view> latest {"v0", "1"};
+    const std::vector<std::string_view> versioned {"v12", "2"};
+    const std::vector<std::string_view> document {".json", "3"};
+    const std::list<std::string> listed {"data.json", "4"};
+    const std::vector<std::string> name {"user_1", "5"};
+    const std::vector<std::string_view> short_name {"v", "6"};
+    const std::vector<std::string_view> upper {"V1", "6"};
+    const std::vector<std::string_view> truncated {"data.jso", "7"};
+    const std::vector<std::string_view> empty {"", "8"};
+    const std::vector<std::string_view> missing {"v1"};
+    return expect::value(node(std::views::all(latest)), "latest 1")
+        && expect::value(node(std::views::all(versioned)), "versioned 2")
+        && expect::value(node(std::views::all(document)), "document 3")
+        && expect::value(node(std::views::all(listed)), "document 4")
+        && expect::value(node(std::views::all(name)), "name 5")
+        && expect::value(node(std::views::all(short_name)), "name 6")
+        && expect::error(node(std::views::all(upper)), Errc::InvalidAction, 0)
+        && expect::error(node(std::views::all(truncated)), Errc::InvalidAction, 0)
+        && expect::error(node(std::views::all(empty)), Errc::InvalidAction, 0)
+        && expect::error(node(std::views::all(missing)), Errc::NotEnoughInput, 1);
+}
+
+} // namespace
+
+int main() {
+    if (!check(routes) || !check(router::flatten(routes))) {
+        return -1;
+    }
+    std::cout << "pattern ok" << std::endl;
+    return 0;
+}
@@ -0,0 +1,138 @@
+#include <array>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <router/flat.hpp>
+#include <router/profile.hpp>
+
+#include "check.hpp"
+
+namespace {
+
+using router::Action;
+using router::ProfileEntry;
+
+constexpr struct GetTag {
+    using value_type = std::string_view;
+
+    static constexpr std::string_view value = "get";
+} get_tag;
+
+constexpr struct SetTag {
+    using value_type = std::string_view;
+
+    static constexpr std::string_view value = "set";
+} set_tag;
+
+constexpr struct ListTag {
+    using value_type = std::string_view;
+
+    static constexpr std::string_view value = "list";
+} list_tag;
+
+constexpr struct DropTag {
+    using value_type = std::string_view;
+
+    static constexpr std::string_view value = "drop";
+} drop_tag;
+
+struct Recording : router::DefaultPolicy {
+    template <class Names>
+    using match = router::RecordingMatch<Names>;
+};
+
+template <class Policy>
+constexpr auto make_routes() {
+    return router::selector<Policy>(
+        Action(get_tag, [] (int id) { return "get " + std::to_string(id); }),
+        Action(set_tag, [] (int id) { return "set " + std::to_string(id); }),
+        Action(list_tag, [] { return std::string("list"); }),
+        Action(drop_tag, [] (int id) { return "drop " + std::to_string(id); })
+    );
+}
+
+constexpr auto recording = make_routes<Recording>();
+
+using names = decltype(recording)::names;
+
+constexpr std::array<ProfileEntry, 4> recorded_profile {{
+    {"get,set,list,drop", "get", 1},
+    {"get,set,list,drop", "set", 3},
+    {"get,set,list,drop", "list", 6},
+    {"get,set,list,drop", "drop", 0},
+}};
+
+using profiled_match = router::ProfiledMatch<names, recorded_profile>;
+
+static_assert(router::signature_v<names> == "get,set,list,drop");
+static_assert(profiled_match::order == std::array<router::index_type_t<4>, 4> {2, 1, 0, 3});
+static_assert(profiled_match::likely_number == 2 && profiled_match::hot_number == 3);
+
+struct Profiled : router::DefaultPolicy {
+    template <class Names>
+    using match = router::ProfiledMatch<Names, recorded_profile>;
+};
+
+constexpr auto profiled = make_routes<Profiled>();
+
+constexpr std::string_view expected_header =
+    "#pragma once\n"
+    "\n"
+    "#include <array>\n"
+    "\n"
+    "#include <router/profile.hpp>\n"
+    "\n"
+    "inline constexpr std::array<router::ProfileEntry, 4> recorded_profile {{\n"
+    "    {\"get,set,list,drop\", \"get\", 1},\n"
+    "    {\"get,set,list,drop\", \"set\", 3},\n"
+    "    {\"get,set,list,drop\", \"list\", 6},\n"
+    "    {\"get,set,list,drop\", \"drop\", 0},\n"
+    "}};\n";
+
+bool record() {
+    const std::vector<std::vector<std::string_view>> run {
+        {"list"}, {"set", "1"}, {"list"}, {"get", "2"}, {"list"},
+        {"set", "3"}, {"list"}, {"list"}, {"set", "4"}, {"list"},
+    };
+    for (const std::vector<std::string_view>& input : run) {
+        if (!recording(std::views::all(input))) {
+            return false;
+        }
+    }
+    const std::vector<std::string_view> unknown {"stat"};
+    return !recording(std::views::all(unknown));
+}
+
+template <class Node>
+bool check(const Node& node) {
+    const std::vector<std::string_view> list {"list"};
+    const std::vector<std::string_view> set {"set", "5"};
+    const std::vector<std::string_view> drop {"drop", "6"};
+    const std::vector<std::string_view> unknown {"stat"};
+    return expect::value(node(std::views::all(list)), "list")
+        && expect::value(node(std::views::all(set)), "set 5")
+        && expect::value(node(std::views::all(drop)), "drop 6")
+        && expect::error(node(std::views::all(unknown)), router::Errc::InvalidAction, 0);
+}
+
+} // namespace
+
+int main() {
+    if (!record()) {
+        return -1;
+    }
+    std::ostringstream header;
+    router::write_profile(header, "recorded_profile");
+    if (header.str() != expected_header) {
+        std::cout << "unexpected profile:\n" << header.str() << std::endl;
+        return -1;
+    }
+    if (!check(profiled) || !check(router::flatten(profiled))) {
+        return -1;
+    }
+    std::cout << "profile ok" << std::endl;
+    return 0;
+}
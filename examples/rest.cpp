@@ -0,0 +1,109 @@
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <ranges>
+#include <string_view>
+#include <vector>
+
+#include <router/flat.hpp>
+
+#include "check.hpp"
+
+namespace {
+
+using router::Action;
+using router::Errc;
+using router::Result;
+using router::Selector;
+using router::rest;
+
+constexpr struct SumTag {
+    using value_type = std::string_view;
+
+    static constexpr std::string_view value = "sum";
+} sum_tag;
+
+constexpr struct CountTag {
+    using value_type = std::string_view;
+
+    static constexpr std::string_view value = "count";
+} count_tag;
+
+Result<int> sum(int first, rest<int> others) {
+    int result = first;
+    for (Result<int> value : others) {
+        if (!value) {
+            return tl::make_unexpected(value.error());
+        }
+        result += *value;
+    }
+    return result;
+}
+
+int count(rest<std::string_view> tokens) {
+    return static_cast<int>(tokens.size());
+}
+
+constexpr Selector routes(
+    Action(sum_tag, &sum),
+    Action(count_tag, &count)
+);
+
+struct Wide {
+    using value_type = std::string_view;
+    using difference_type = std::ptrdiff_t;
+
+    const std::string_view* current = nullptr;
+    std::array<char, 128> padding {};
+
+    std::string_view operator *() const {
+        return *current;
+    }
+
+    Wide& operator ++() {
+        ++current;
+        return *this;
+    }
+
+    Wide operator ++(int) {
+        const Wide result = *this;
+        ++current;
+        return result;
+    }
+
+    friend bool operator ==(const Wide& lhs, const Wide& rhs) {
+        return lhs.current == rhs.current;
+    }
+};
+
+template <class Node>
+bool check(const Node& node) {
+    const std::vector<std::string_view> sum {"sum", "1", "2", "3"};
+    const std::list<std::string_view> listed {"sum", "1", "2", "3"};
+    const std::vector<std::string_view> single {"sum", "7"};
+    const std::vector<std::string_view> empty {"count"};
+    const std::vector<std::string_view> invalid {"sum", "1", "x", "3"};
+    const std::vector<std::string_view> missing {"sum"};
+    const std::array<std::string_view, 4> tokens {"count", "a", "b", "c"};
+    const auto wide = std::ranges::subrange(Wide {tokens.data()}, Wide {tokens.data() + tokens.size()});
+    static_assert(!rest<int>::is_inline_v<Wide>);
+    return expect::value(node(std::views::all(sum)), 6)
+        && expect::value(node(std::views::all(listed)), 6)
+        && expect::value(node(std::views::all(single)), 7)
+        && expect::value(node(std::views::all(empty)), 0)
+        && expect::value(node(wide), 3)
+        && expect::error(node(std::views::all(invalid)), Errc::InvalidArgument, 2)
+        && expect::error(node(std::views::all(missing)), Errc::NotEnoughInput, 1);
+}
+
+} // namespace
+
+int main() {
+    if (!check(routes) || !check(router::flatten(routes))) {
+        return -1;
+    }
+    std::cout << "rest ok" << std::endl;
+    return 0;
+}
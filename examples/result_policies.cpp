@@ -0,0 +1,147 @@
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <router/flat.hpp>
+
+namespace {
+
+using router::Action;
+using router::Errc;
+using router::Result;
+
+constexpr struct GetTag {
+    using value_type = std::string_view;
+
+    static constexpr std::string_view value = "get";
+} get_tag;
+
+constexpr struct SetTag {
+    using value_type = std::string_view;
+
+    static constexpr std::string_view value = "set";
+} set_tag;
+
+struct Value {
+    static inline int moves = 0;
+
+    int value;
+
+    explicit Value(int value) : value(value) {}
+
+    Value(Value&& other) noexcept : value(other.value) {
+        ++moves;
+    }
+};
+
+struct Store {
+    int value = 0;
+};
+
+template <class Policy>
+constexpr auto make_routes() {
+    return router::selector<Policy>(
+        Action(get_tag, [] (Store& store) { return Value(store.value); }),
+        Action(set_tag, [] (Store& store, int value) { return std::exchange(store.value, value); })
+    );
+}
+
+template <class Policy>
+constexpr auto make_setter() {
+    return router::selector<Policy>(
+        Action(set_tag, [] (Store& store, int value) { store.value = value; })
+    );
+}
+
+bool check_expected() {
+    constexpr auto routes = make_routes<router::DefaultPolicy>();
+    static_assert(std::is_same_v<decltype(routes)::result_type, Result<std::variant<int, Value>>>);
+    Store store;
+    const std::vector<std::string_view> set {"set", "42"};
+    const std::vector<std::string_view> invalid {"set", "x"};
+    const std::vector<std::string_view> missing {"set"};
+    return routes(std::views::all(set), store).has_value() && store.value == 42
+        && routes(std::views::all(invalid), store).error().code == Errc::InvalidArgument
+        && router::flatten(routes)(std::views::all(missing), store).error().code == Errc::NotEnoughInput
+        && store.value == 42;
+}
+
+#ifdef __cpp_exceptions
+struct Throwing : router::DefaultPolicy {
+    using result = router::ThrowingResult;
+};
+
+bool check_throwing() {
+    constexpr auto routes = make_routes<Throwing>();
+    constexpr auto flat = router::flatten(routes);
+    Store store;
+    const std::vector<std::string_view> set {"set", "7"};
+    const std::vector<std::string_view> get {"get"};
+    const std::vector<std::string_view> invalid {"put", "7"};
+    static_assert(std::is_same_v<decltype(routes)::result_type, std::variant<int, Value>>);
+    static_assert(!noexcept(routes(std::views::all(set), store)));
+    static_assert(std::is_void_v<decltype(make_setter<Throwing>()(std::views::all(set), store))>);
+    make_setter<Throwing>()(std::views::all(set), store);
+    Value::moves = 0;
+    const auto value = flat(std::views::all(get), store);
+    if (std::get<Value>(value).value != 7 || Value::moves > 1) {
+        return false;
+    }
+    try {
+        (void) routes(std::views::all(invalid), store);
+        return false;
+    } catch (const router::Exception& e) {
+        if (e.error.code != Errc::InvalidAction || e.error.token != "put" || std::string_view(e.what()).empty()) {
+            return false;
+        }
+    }
+    try {
+        flat.dispatch(std::views::all(invalid), store, [] (const auto&) {});
+        return false;
+    } catch (const router::Exception& e) {
+        return e.error.code == Errc::InvalidAction;
+    }
+}
+#endif
+
+#ifdef __cpp_lib_expected
+struct StdExpected : router::DefaultPolicy {
+    using result = router::StdExpectedResult;
+};
+
+bool check_std_expected() {
+    constexpr auto routes = make_routes<StdExpected>();
+    Store store;
+    const std::vector<std::string_view> set {"set", "9"};
+    const std::vector<std::string_view> extra {"set", "9", "9"};
+    return routes(std::views::all(set), store).has_value() && store.value == 9
+        && routes(std::views::all(extra), store).error().code == Errc::TooManyArguments;
+}
+#endif
+
+} // namespace
+
+int main() {
+    if (!check_expected()) {
+        std::cout << "expected result policy failed" << std::endl;
+        return -1;
+    }
+#ifdef __cpp_exceptions
+    if (!check_throwing()) {
+        std::cout << "throwing result policy failed" << std::endl;
+        return -1;
+    }
+#endif
+#ifdef __cpp_lib_expected
+    if (!check_std_expected()) {
+        std::cout << "std::expected result policy failed" << std::endl;
+        return -1;
+    }
+#endif
+    std::cout << "result policies ok" << std::endl;
+    return 0;
+}
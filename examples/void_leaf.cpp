@@ -0,0 +1,84 @@
+#include <iostream>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <router/flat.hpp>
+
+namespace {
+
+using router::Action;
+using router::Errc;
+using router::Result;
+using router::Selector;
+using router::argument;
+
+constexpr struct SetTag {
+    using value_type = std::string_view;
+
+    static constexpr std::string_view value = "set";
+} set_tag;
+
+constexpr struct CheckTag {
+    using value_type = std::string_view;
+
+    static constexpr std::string_view value = "check";
+} check_tag;
+
+constexpr struct SlotTag {
+    using value_type = std::string_view;
+
+    static constexpr std::string_view value = "slot";
+} slot_tag;
+
+struct Store {
+    int values[2] {};
+};
+
+constexpr Selector routes(
+    Action(set_tag, [] (Store& store, int value) { store.values[0] = value; }),
+    Action(check_tag, [] (Store& store, int value) -> Result<void> {
+        if (store.values[0] != value) {
+            return tl::make_unexpected(Errc::NotFound);
+        }
+        return {};
+    }),
+    Action(slot_tag, argument<int>(
+        Action(set_tag, [] (Store& store, int slot, int value) { store.values[slot % 2] = value; })
+    ))
+);
+
+static_assert(std::is_same_v<decltype(routes)::return_type, Result<void>>);
+
+template <class Node>
+bool check(const Node& node) {
+    Store store;
+    const std::vector<std::string_view> set {"set", "7"};
+    const std::vector<std::string_view> check {"check", "7"};
+    const std::vector<std::string_view> mismatch {"check", "8"};
+    const std::vector<std::string_view> slot {"slot", "1", "set", "9"};
+    const std::vector<std::string_view> invalid {"set", "x"};
+    const std::vector<std::string_view> missing {"slot", "1"};
+    int calls = 0;
+    const auto count = [&] { ++calls; };
+    return node(std::views::all(set), store).has_value() && store.values[0] == 7
+        && node(std::views::all(check), store).has_value()
+        && node(std::views::all(mismatch), store).error().code == Errc::NotFound
+        && node(std::views::all(slot), store).has_value() && store.values[1] == 9
+        && node(std::views::all(invalid), store).error().code == Errc::InvalidArgument
+        && node(std::views::all(missing), store).error().code == Errc::NotEnoughInput
+        && store.values[0] == 7
+        && node.dispatch(std::views::all(check), store, count).has_value() && calls == 1
+        && !node.dispatch(std::views::all(mismatch), store, count).has_value() && calls == 1;
+}
+
+} // namespace
+
+int main() {
+    if (!check(routes) || !check(router::flatten(routes))) {
+        std::cout << "void leaf dispatch failed" << std::endl;
+        return -1;
+    }
+    std::cout << "void leaf ok" << std::endl;
+    return 0;
+}
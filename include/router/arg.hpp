@@ -0,0 +1,187 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include <router/match.hpp>
+#include <router/router.hpp>
+
+namespace router {
+
+template <class ... Ts>
+struct OneOf : std::variant<Ts ...> {
+    using std::variant<Ts ...>::variant;
+};
+
+template <class ... Ts>
+using one_of = OneOf<Ts ...>;
+
+template <class ... Ts>
+struct TokenClasses<OneOf<Ts ...>> {
+    static constexpr TokenClass value = (TokenClass::None | ... | token_classes_v<Ts>);
+};
+
+template <class ... Ts>
+struct Parser<OneOf<Ts ...>> {
+    template <class T, class Value, class ... Context>
+    static constexpr bool parse_alternative(TokenClass classes, Value&& value, Result<OneOf<Ts ...>>& result,
+                                            Context& ... context) {
+        if ((token_classes_v<T> & classes) == TokenClass::None) {
+            return false;
+        }
+        Result<T> alternative = router::parse<T>(std::forward<Value>(value), context ...);
+        if (alternative) {
+            result = OneOf<Ts ...>(std::in_place_type<T>, std::move(*alternative));
+        } else {
+            result = tl::make_unexpected(alternative.error());
+        }
+        return true;
+    }
+
+    template <class Value, class ... Context>
+    static constexpr Result<OneOf<Ts ...>> parse(Value&& value, Context& ... context)
+        noexcept((is_nothrow_parse_v<Ts, Value&&, std::tuple<Context& ...>> && ...)) {
+        static_assert(std::is_convertible_v<Value&&, std::string_view>, "one_of requires string tokens");
+        const TokenClass classes = classify(std::string_view(value));
+        Result<OneOf<Ts ...>> result = tl::make_unexpected(Errc::InvalidArgument);
+        (parse_alternative<Ts>(classes, value, result, context ...) || ...);
+        return result;
+    }
+};
+
+template <auto min, auto max>
+struct InRange {
+    static_assert(!(max < min), "in_range requires min <= max");
+
+    template <class T>
+    static constexpr bool accepts_value(const T& value) {
+        return !(value < min) && !(max < value);
+    }
+};
+
+template <auto min, auto max>
+using in_range = InRange<min, max>;
+
+template <std::size_t size>
+struct MaxLength {
+    static constexpr bool accepts_token(std::string_view token) {
+        return token.size() <= size;
+    }
+};
+
+template <std::size_t size>
+using max_length = MaxLength<size>;
+
+template <TokenClass classes>
+struct Charset {
+    static constexpr bool accepts_token(std::string_view token) {
+        return (classify(token) & classes) != TokenClass::None;
+    }
+};
+
+template <TokenClass classes>
+using charset = Charset<classes>;
+
+template <class T>
+struct IsInRange : std::false_type {};
+
+template <auto min, auto max>
+struct IsInRange<InRange<min, max>> : std::true_type {};
+
+template <class T>
+inline constexpr bool is_in_range_v = IsInRange<T>::value;
+
+template <class Constraint>
+inline constexpr bool accepts_token(std::string_view token) {
+    if constexpr (requires { Constraint::accepts_token(token); }) {
+        return Constraint::accepts_token(token);
+    } else {
+        return true;
+    }
+}
+
+template <class Constraint, class T>
+inline constexpr bool accepts_value(const T& value) {
+    if constexpr (requires { Constraint::accepts_value(value); }) {
+        return Constraint::accepts_value(value);
+    } else {
+        return true;
+    }
+}
+
+template <class T, class Constraint>
+struct IntegerBounds {
+    static constexpr T min = std::numeric_limits<T>::min();
+    static constexpr T max = std::numeric_limits<T>::max();
+};
+
+template <class T, auto min_value, auto max_value>
+struct IntegerBounds<T, InRange<min_value, max_value>> {
+    static_assert(std::in_range<T>(min_value) && std::in_range<T>(max_value), "in_range bounds must fit the type");
+
+    static constexpr T min = static_cast<T>(min_value);
+    static constexpr T max = static_cast<T>(max_value);
+};
+
+template <class T, class ... Constraints>
+struct Constrained {
+    T value;
+
+    constexpr operator const T&() const & {
+        return value;
+    }
+
+    constexpr operator T&&() && {
+        return std::move(value);
+    }
+};
+
+template <class T, class ... Constraints>
+using constrained = Constrained<T, Constraints ...>;
+
+template <class T, class ... Constraints>
+struct TokenClasses<Constrained<T, Constraints ...>> : TokenClasses<T> {};
+
+template <class T, class ... Constraints>
+struct Parser<Constrained<T, Constraints ...>> {
+    using type = Constrained<T, Constraints ...>;
+
+    template <class Value, class ... Context>
+    static constexpr Result<type> parse(Value&& value, Context& ... context) noexcept(is_nothrow_parse_v<T, Value&&, std::tuple<Context& ...>>) {
+        if constexpr (std::is_convertible_v<Value&&, std::string_view>) {
+            const std::string_view token(value);
+            if (!(accepts_token<Constraints>(token) && ...)) {
+                return tl::make_unexpected(Errc::InvalidArgument);
+            }
+            if constexpr (is_integer_v<T>) {
+                const std::optional<T> result = parse_integer<T>(
+                    token,
+                    std::max({std::numeric_limits<T>::min(), IntegerBounds<T, Constraints>::min ...}),
+                    std::min({std::numeric_limits<T>::max(), IntegerBounds<T, Constraints>::max ...})
+                );
+                if (!result || !((is_in_range_v<Constraints> || accepts_value<Constraints>(*result)) && ...)) {
+                    return tl::make_unexpected(Errc::InvalidArgument);
+                }
+                return type {*result};
+            }
+        }
+        Result<T> result = router::parse<T>(std::forward<Value>(value), context ...);
+        if (!result) {
+            return tl::make_unexpected(result.error());
+        }
+        if (!(accepts_value<Constraints>(*result) && ...)) {
+            return tl::make_unexpected(Errc::InvalidArgument);
+        }
+        return type {std::move(*result)};
+    }
+};
+
+} // namespace router
@@ -0,0 +1,397 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <router/router.hpp>
+
+namespace router {
+
+template <class ... Ts>
+struct List {};
+
+template <class ... Lists>
+struct Concat;
+
+template <>
+struct Concat<> {
+    using type = List<>;
+};
+
+template <class ... Ts>
+struct Concat<List<Ts ...>> {
+    using type = List<Ts ...>;
+};
+
+template <class ... Ts, class ... Qs, class ... Lists>
+struct Concat<List<Ts ...>, List<Qs ...>, Lists ...> : Concat<List<Ts ..., Qs ...>, Lists ...> {};
+
+template <class ... Lists>
+using concat_t = typename Concat<Lists ...>::type;
+
+template <class T, class ... Ts>
+inline constexpr std::size_t index_of(List<Ts ...>) {
+    constexpr std::array<bool, sizeof ... (Ts)> same {std::is_same_v<T, Ts> ...};
+    return std::ranges::find(same, true) - same.begin();
+}
+
+template <class ... Ts>
+inline constexpr std::size_t size(List<Ts ...>) {
+    return sizeof ... (Ts);
+}
+
+template <std::size_t i>
+struct Element {};
+
+template <class T>
+struct IsElement : std::false_type {};
+
+template <std::size_t i>
+struct IsElement<Element<i>> : std::true_type {};
+
+struct Function {};
+
+struct Nested {};
+
+template <class ... Steps>
+struct Path {};
+
+template <class Path, class Step>
+struct Append;
+
+template <class ... Steps, class Step>
+struct Append<Path<Steps ...>, Step> {
+    using type = Path<Steps ..., Step>;
+};
+
+template <class Path, class Step>
+using append_t = typename Append<Path, Step>::type;
+
+template <class Node>
+inline constexpr const Node& follow(const Node& node, Path<>) {
+    return node;
+}
+
+template <class Node, std::size_t i, class ... Steps>
+inline constexpr const auto& follow(const Node& node, Path<Element<i>, Steps ...>) {
+    return follow(std::get<i>(node.actions), Path<Steps ...>());
+}
+
+template <class Node, class ... Steps>
+inline constexpr const auto& follow(const Node& node, Path<Function, Steps ...>) {
+    return follow(node.f, Path<Steps ...>());
+}
+
+template <class Node, class ... Steps>
+inline constexpr const auto& follow(const Node& node, Path<Nested, Steps ...>) {
+    return follow(node.selector, Path<Steps ...>());
+}
+
+template <class ... Steps>
+inline constexpr std::size_t depth_of(Path<Steps ...>) {
+    return (std::size_t(IsElement<Steps>::value) + ... + 0);
+}
+
+template <class Node, class Path, class Captured>
+struct SelectState {};
+
+template <class Node, class Path, class Captured>
+struct CaptureState {};
+
+template <class Node, class Path, class Captured>
+struct Leaf {};
+
+template <class Node, class Path, class Captured>
+struct Lower {
+    using target = Leaf<Node, Path, Captured>;
+    using states = List<>;
+    using leaves = List<target>;
+};
+
+template <class Tag, class F, class Path, class Captured>
+    requires (is_selector_v<F> || is_argument_v<F>)
+struct Lower<Action<Tag, F>, Path, Captured> : Lower<F, append_t<Path, Function>, Captured> {};
+
+template <class Node, class Path, class Captured>
+    requires is_selector_v<Node>
+struct Lower<Node, Path, Captured> {
+    using actions = std::remove_cv_t<decltype(Node::actions)>;
+
+    static constexpr std::size_t edges = Node::reachable;
+
+    template <std::size_t i>
+    using child = Lower<std::tuple_element_t<i, actions>, append_t<Path, Element<i>>, Captured>;
+
+    template <class Sequence>
+    struct Children;
+
+    template <std::size_t ... i>
+    struct Children<std::index_sequence<i ...>> {
+        using states = concat_t<typename child<i>::states ...>;
+        using leaves = concat_t<typename child<i>::leaves ...>;
+    };
+
+    using children = Children<std::make_index_sequence<edges>>;
+
+    using target = SelectState<Node, Path, Captured>;
+    using states = concat_t<List<target>, typename children::states>;
+    using leaves = typename children::leaves;
+};
+
+template <class Node, class Path, class ... Captured>
+    requires is_argument_v<Node>
+struct Lower<Node, Path, List<Captured ...>> {
+    using child = Lower<typename Node::selector_type, append_t<Path, Nested>, List<Captured ..., typename Node::value_type>>;
+
+    using target = CaptureState<Node, Path, List<Captured ...>>;
+    using states = concat_t<List<target>, typename child::states>;
+    using leaves = typename child::leaves;
+};
+
+template <class Tree>
+struct Flat {
+    static_assert(is_selector_v<Tree>, "Flat requires a selector at the root");
+
+    using return_type = typename Tree::return_type;
+
+    using result_policy = typename Tree::result_policy;
+
+    using result_type = typename Tree::result_type;
+
+    using lowered = Lower<Tree, Path<>, List<>>;
+    using states = typename lowered::states;
+    using leaves = typename lowered::leaves;
+
+    template <class Sink>
+    using sink_result = typename Tree::template sink_result<Sink>;
+
+    template <class Sink>
+    using continued = Result<result_value_t<sink_result<Sink>>>;
+
+    enum class Kind : std::uint8_t {
+        Invalid,
+        State,
+        Leaf,
+    };
+
+    struct Transition {
+        Kind kind = Kind::Invalid;
+        bool consume = false;
+        std::size_t target = 0;
+    };
+
+    struct State {
+        bool capture = false;
+        std::size_t begin = 0;
+        std::size_t slot = 0;
+        std::size_t next = 0;
+        std::size_t depth = 0;
+    };
+
+    template <class Target>
+    static constexpr Transition transition(bool consume) {
+        if constexpr (index_of<Target>(leaves()) < size(leaves())) {
+            return Transition {Kind::Leaf, consume, index_of<Target>(leaves())};
+        } else {
+            return Transition {Kind::State, consume, index_of<Target>(states())};
+        }
+    }
+
+    template <class Node, class Path, class Captured>
+    static constexpr std::size_t transitions_number(SelectState<Node, Path, Captured>) {
+        return Node::edges;
+    }
+
+    template <class Node, class Path, class Captured>
+    static constexpr std::size_t transitions_number(CaptureState<Node, Path, Captured>) {
+        return 0;
+    }
+
+    template <class ... States>
+    static constexpr std::size_t total_transitions(List<States ...>) {
+        return (transitions_number(States()) + ... + 0);
+    }
+
+    template <class Node, class Path, class Captured, class Output>
+    static constexpr void fill(SelectState<Node, Path, Captured>, Output output) {
+        using lowered_node = Lower<Node, Path, Captured>;
+        [&] <std::size_t ... i> (std::index_sequence<i ...>) {
+            ((output[i] = transition<typename lowered_node::template child<i>::target>(i < Node::names::size)), ...);
+        } (std::make_index_sequence<lowered_node::edges>());
+    }
+
+    template <class Node, class Path, class Captured, class Output>
+    static constexpr void fill(CaptureState<Node, Path, Captured>, Output) {}
+
+    static constexpr auto transition_table = [] <class ... States> (List<States ...>) {
+        std::array<Transition, total_transitions(states())> result {};
+        std::size_t begin = 0;
+        ((fill(States(), result.begin() + begin), begin += transitions_number(States())), ...);
+        return result;
+    } (states());
+
+    template <class Node, class Path, class ... Captured>
+    static constexpr State describe(SelectState<Node, Path, List<Captured ...>>, std::size_t begin) {
+        return State {false, begin, sizeof ... (Captured), 0, depth_of(Path())};
+    }
+
+    template <class Node, class Path, class ... Captured>
+    static constexpr State describe(CaptureState<Node, Path, List<Captured ...>>, std::size_t begin) {
+        using next = typename Lower<Node, Path, List<Captured ...>>::child::target;
+        return State {true, begin, sizeof ... (Captured), index_of<next>(states()), depth_of(Path())};
+    }
+
+    static constexpr auto state_table = [] <class ... States> (List<States ...>) {
+        std::array<State, sizeof ... (States)> result {};
+        std::size_t i = 0;
+        std::size_t begin = 0;
+        ((result[i++] = describe(States(), begin), begin += transitions_number(States())), ...);
+        return result;
+    } (states());
+
+    template <class Node, class Path, class ... Captured>
+    static constexpr std::size_t captured_number(Leaf<Node, Path, List<Captured ...>>) {
+        return sizeof ... (Captured);
+    }
+
+    static constexpr std::size_t captures = [] <class ... Leaves> (List<Leaves ...>) {
+        return std::max({std::size_t(0), captured_number(Leaves()) ...});
+    } (leaves());
+
+    Tree tree;
+
+    template <class T>
+    constexpr explicit Flat(T&& tree) : tree(std::forward<T>(tree)) {}
+
+    template <class Iterator, class Sentinel, class Sink, class ... Args>
+    struct Program {
+        using Reference = std::iter_reference_t<Iterator>;
+        using Captures = std::array<Iterator, captures>;
+        using Rest = std::ranges::subrange<Iterator, Sentinel>;
+        using Return = continued<Sink>;
+
+        using Match = std::size_t (*)(Reference);
+        using Invoke = Return (*)(const Tree&, const Captures&, Rest, std::size_t, Sink*, Args&& ...);
+
+        template <class Node, class Path, class Captured>
+        static constexpr Match matcher(SelectState<Node, Path, Captured>) {
+            return [] (Reference token) -> std::size_t {
+                return Node::select(token);
+            };
+        }
+
+        template <class Node, class Path, class Captured>
+        static constexpr Match matcher(CaptureState<Node, Path, Captured>) {
+            return nullptr;
+        }
+
+        template <class Node, class Path, class ... Captured>
+        static constexpr Invoke invoker(Leaf<Node, Path, List<Captured ...>>) {
+            return [] (const Tree& tree, const Captures& captured, Rest rest, std::size_t position, Sink* sink,
+                       Args&& ... args) -> Return {
+                Return result = Emplace<Return>().emplace([&] {
+                    return [&] <std::size_t ... i> (std::index_sequence<i ...>) {
+                        return continue_to(follow(tree, Path()), *sink, rest, std::forward<Args>(args) ...,
+                                           defer<Captured>(captured[i]) ...);
+                    } (std::index_sequence_for<Captured ...>());
+                });
+                if (!result) {
+                    result.error().index += position;
+                    result.error().depth += depth_of(Path());
+                }
+                return result;
+            };
+        }
+
+        static constexpr auto matchers = [] <class ... States> (List<States ...>) {
+            return std::array<Match, sizeof ... (States)> {matcher(States()) ...};
+        } (states());
+
+        static constexpr auto invokers = [] <class ... Leaves> (List<Leaves ...>) {
+            return std::array<Invoke, sizeof ... (Leaves)> {invoker(Leaves()) ...};
+        } (leaves());
+    };
+
+    template <class ... Args>
+    result_type operator ()(std::ranges::input_range auto input, Args&& ... args) const
+        noexcept(is_nothrow_v<Flat, decltype(input), Args ...> && result_policy::nothrow) {
+        return result_policy::make([&] {
+            Emplace<return_type> emplace;
+            return run(input, &emplace, std::forward<Args>(args) ...);
+        });
+    }
+
+    template <class ... Args>
+    auto dispatch(std::ranges::input_range auto input, Args&& ... args) const {
+        return result_policy::make([&] {
+            return with_sink([&] <class Sink> (Sink& sink, auto&& ... args) {
+                return run(input, &sink, std::forward<decltype(args)>(args) ...);
+            }, std::forward<Args>(args) ...);
+        });
+    }
+
+    template <class Sink, class ... Args>
+    continued<Sink> run(std::ranges::input_range auto input, Sink* sink, Args&& ... args) const {
+        using Iterator = decltype(std::ranges::begin(input));
+        using Sentinel = decltype(std::ranges::end(input));
+        using program = Program<Iterator, Sentinel, Sink, Args ...>;
+        typename program::Captures captured {};
+        auto it = std::ranges::begin(input);
+        const auto last = std::ranges::end(input);
+        std::size_t state = 0;
+        std::size_t position = 0;
+        while (true) {
+            const State& current = state_table[state];
+            if (it == last) {
+                return tl::make_unexpected(Error {Errc::NotEnoughInput, position, current.depth});
+            }
+            if (current.capture) {
+                captured[current.slot] = it;
+                ++it;
+                ++position;
+                state = current.next;
+                continue;
+            }
+            const Transition& next = transition_table[current.begin + program::matchers[state](*it)];
+            if (next.consume) {
+                ++it;
+                ++position;
+            }
+            switch (next.kind) {
+                case Kind::State:
+                    state = next.target;
+                    continue;
+                case Kind::Leaf:
+                    return program::invokers[next.target](
+                        tree, captured, typename program::Rest(it, last), position, sink, std::forward<Args>(args) ...
+                    );
+                case Kind::Invalid:
+                    break;
+            }
+            return tl::make_unexpected(Error {Errc::InvalidAction, position, current.depth, error_token(*it)});
+        }
+    }
+};
+
+template <class Tree>
+inline constexpr auto flatten(Tree&& tree) {
+    return Flat<std::decay_t<Tree>>(std::forward<Tree>(tree));
+}
+
+template <class Tree>
+struct ReturnType<Flat<Tree>> {
+    using type = typename Flat<Tree>::return_type;
+};
+
+template <class Tree, class Range, class ... Args>
+struct IsNothrow<Flat<Tree>, Range, Args ...>
+    : IsNothrow<Tree, std::ranges::subrange<std::ranges::iterator_t<Range>, std::ranges::sentinel_t<Range>>, Args ...> {};
+
+} // namespace router
@@ -0,0 +1,783 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <router/token.hpp>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace router {
+
+inline constexpr std::size_t max_packed_size = 16;
+
+struct Packed {
+    std::size_t size = 0;
+    std::uint64_t head = 0;
+    std::uint64_t tail = 0;
+
+    friend constexpr bool operator ==(const Packed& lhs, const Packed& rhs) {
+        return ((lhs.size ^ rhs.size) | (lhs.head ^ rhs.head) | (lhs.tail ^ rhs.tail)) == 0;
+    }
+};
+
+template <class T>
+inline constexpr std::uint64_t load(const char* data) {
+    if (std::is_constant_evaluated()) {
+        std::uint64_t result = 0;
+        for (std::size_t i = 0; i < sizeof(T); ++i) {
+            const std::size_t shift = std::endian::native == std::endian::little ? i : sizeof(T) - 1 - i;
+            result |= std::uint64_t(static_cast<unsigned char>(data[i])) << (8 * shift);
+        }
+        return result;
+    }
+    T result;
+    std::memcpy(&result, data, sizeof(T));
+    return result;
+}
+
+inline constexpr Packed pack(std::string_view value) {
+    const char* const data = value.data();
+    const std::size_t size = value.size();
+    if (size > max_packed_size) {
+        return Packed {size, 0, 0};
+    }
+    if (size >= 8) {
+        return Packed {size, load<std::uint64_t>(data), load<std::uint64_t>(data + size - 8)};
+    }
+    if (size >= 4) {
+        return Packed {size, load<std::uint32_t>(data), load<std::uint32_t>(data + size - 4)};
+    }
+    if (size > 0) {
+        const auto byte = [&] (std::size_t i) { return std::uint64_t(static_cast<unsigned char>(data[i])); };
+        return Packed {size, byte(0) | byte(size / 2) << 8 | byte(size - 1) << 16, 0};
+    }
+    return Packed {};
+}
+
+inline constexpr bool equal(const Packed& packed, std::string_view name, std::string_view token) {
+    if (token.size() <= max_packed_size) {
+        return packed == pack(token);
+    }
+    return name == token;
+}
+
+template <class ... Actions>
+struct Names {
+    static constexpr std::size_t size = sizeof ... (Actions);
+
+    static constexpr std::tuple<std::remove_cvref_t<decltype(Actions::name)> ...> values {Actions::name ...};
+};
+
+template <class Names>
+struct StringNames : std::false_type {};
+
+template <class ... Actions>
+    requires (std::is_convertible_v<decltype(Actions::name), std::string_view> && ...)
+struct StringNames<Names<Actions ...>> : std::true_type {
+    static constexpr std::array<std::string_view, sizeof ... (Actions)> values {std::string_view(Actions::name) ...};
+
+    static constexpr std::array<Packed, sizeof ... (Actions)> packed {pack(Actions::name) ...};
+
+    static constexpr std::array<std::uint64_t, sizeof ... (Actions)> fingerprints {fingerprint(Actions::name) ...};
+};
+
+template <class Names>
+inline constexpr bool has_string_names_v = StringNames<Names>::value;
+
+template <class Names>
+inline constexpr auto& string_names_v = StringNames<Names>::values;
+
+template <class Names>
+inline constexpr auto& packed_names_v = StringNames<Names>::packed;
+
+template <class Names>
+inline constexpr auto& fingerprint_names_v = StringNames<Names>::fingerprints;
+
+template <class T>
+inline constexpr bool is_integer_v = std::is_integral_v<T>
+    && !std::is_same_v<T, bool>
+    && !std::is_same_v<T, char>
+    && !std::is_same_v<T, wchar_t>
+    && !std::is_same_v<T, char8_t>
+    && !std::is_same_v<T, char16_t>
+    && !std::is_same_v<T, char32_t>;
+
+enum class TokenClass : std::uint8_t {
+    None = 0,
+    Digits = 1,
+    Number = 2,
+    Hex = 4,
+    Identifier = 8,
+    Any = 16,
+};
+
+inline constexpr TokenClass operator |(TokenClass lhs, TokenClass rhs) {
+    return static_cast<TokenClass>(static_cast<std::uint8_t>(lhs) | static_cast<std::uint8_t>(rhs));
+}
+
+inline constexpr TokenClass operator &(TokenClass lhs, TokenClass rhs) {
+    return static_cast<TokenClass>(static_cast<std::uint8_t>(lhs) & static_cast<std::uint8_t>(rhs));
+}
+
+inline constexpr std::array<TokenClass, 256> token_classes = [] {
+    std::array<TokenClass, 256> result {};
+    for (std::size_t c = 0; c < result.size(); ++c) {
+        if (c >= '0' && c <= '9') {
+            result[c] = TokenClass::Digits | TokenClass::Hex | TokenClass::Identifier;
+        } else if ((c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F')) {
+            result[c] = TokenClass::Hex | TokenClass::Identifier;
+        } else if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_') {
+            result[c] = TokenClass::Identifier;
+        }
+    }
+    return result;
+} ();
+
+inline constexpr TokenClass classify(std::string_view token) {
+    if (token.empty()) {
+        return TokenClass::Any;
+    }
+    const TokenClass head = token_classes[static_cast<unsigned char>(token.front())];
+    TokenClass tail = TokenClass::Digits | TokenClass::Hex | TokenClass::Identifier;
+    for (const char c : token.substr(1)) {
+        tail = tail & token_classes[static_cast<unsigned char>(c)];
+    }
+    const bool digit = (head & TokenClass::Digits) != TokenClass::None;
+    const bool sign = token.front() == '-' && token.size() > 1;
+    TokenClass result = TokenClass::Any | (head & tail & (digit ? TokenClass::Digits | TokenClass::Hex : head));
+    if ((tail & TokenClass::Digits) != TokenClass::None && (digit || sign)) {
+        result = result | TokenClass::Number;
+    }
+    return result;
+}
+
+template <class T, class = void>
+struct TokenClasses {
+    static constexpr TokenClass value = TokenClass::Any;
+};
+
+template <class T>
+struct TokenClasses<T, std::enable_if_t<is_integer_v<T>>> {
+    static constexpr TokenClass value = std::is_signed_v<T> ? TokenClass::Number : TokenClass::Digits;
+};
+
+template <class T>
+inline constexpr TokenClass token_classes_v = TokenClasses<T>::value;
+
+template <class Names>
+struct IntegralNames : std::false_type {};
+
+template <class ... Actions>
+    requires (sizeof ... (Actions) > 0 && (is_integer_v<std::remove_cvref_t<decltype(Actions::name)>> && ...))
+struct IntegralNames<Names<Actions ...>> : std::true_type {
+    using value_type = std::common_type_t<std::remove_cvref_t<decltype(Actions::name)> ...>;
+
+    static constexpr std::array<value_type, sizeof ... (Actions)> values {static_cast<value_type>(Actions::name) ...};
+};
+
+template <class Names>
+inline constexpr bool has_integral_names_v = IntegralNames<Names>::value;
+
+template <std::size_t n>
+using index_type_t = std::conditional_t<(n < 255), std::uint8_t,
+    std::conditional_t<(n < 65535), std::uint16_t, std::uint32_t>>;
+
+template <class Names>
+inline constexpr bool is_first_name(std::size_t index) {
+    const auto& names = string_names_v<Names>;
+    return std::find(names.begin(), names.begin() + index, names[index]) == names.begin() + index;
+}
+
+template <class Names>
+inline constexpr std::size_t distinct_names_v = [] {
+    std::size_t result = 0;
+    for (std::size_t i = 0; i < Names::size; ++i) {
+        result += is_first_name<Names>(i);
+    }
+    return result;
+} ();
+
+template <class Names>
+inline constexpr std::array<index_type_t<Names::size>, distinct_names_v<Names>> first_names_v = [] {
+    std::array<index_type_t<Names::size>, distinct_names_v<Names>> result {};
+    for (std::size_t i = 0, n = 0; i < Names::size; ++i) {
+        if (is_first_name<Names>(i)) {
+            result[n++] = static_cast<index_type_t<Names::size>>(i);
+        }
+    }
+    return result;
+} ();
+
+template <class Names, class T, class F>
+inline constexpr decltype(auto) with_string_matcher(const T& token, F&& f) {
+    if constexpr (std::is_same_v<T, Token>) {
+        return f([&] (std::size_t i) {
+            return fingerprint_names_v<Names>[i] == token.fingerprint && string_names_v<Names>[i] == token.value;
+        });
+    } else {
+        const std::string_view value(token);
+        if (value.size() > max_packed_size) {
+            return f([&] (std::size_t i) { return string_names_v<Names>[i] == value; });
+        }
+        const Packed packed = pack(value);
+        return f([&] (std::size_t i) { return packed_names_v<Names>[i] == packed; });
+    }
+}
+
+template <class Names>
+struct LinearMatch {
+    template <class T>
+    static constexpr std::size_t find(const T& token) {
+        if constexpr (has_string_names_v<Names> && std::is_same_v<T, Token>) {
+            return find_fingerprint(token);
+        } else if constexpr (has_string_names_v<Names> && std::is_convertible_v<const T&, std::string_view>) {
+            return find_string(token);
+        } else {
+            return find_value(token);
+        }
+    }
+
+    static constexpr std::size_t find_string(std::string_view token) {
+        const auto& names = string_names_v<Names>;
+        if (token.size() > max_packed_size) {
+            return std::ranges::find(names, token) - names.begin();
+        }
+        return std::ranges::find(packed_names_v<Names>, pack(token)) - packed_names_v<Names>.begin();
+    }
+
+    static constexpr std::size_t find_fingerprint(const Token& token) {
+        for (std::size_t i = 0; i < Names::size; ++i) {
+            if (fingerprint_names_v<Names>[i] == token.fingerprint && string_names_v<Names>[i] == token.value) {
+                return i;
+            }
+        }
+        return Names::size;
+    }
+
+    template <class T>
+    static constexpr std::size_t find_value(const T& token) {
+        return [&] <std::size_t ... i> (std::index_sequence<i ...>) {
+            std::size_t result = Names::size;
+            (void) ((std::get<i>(Names::values) == token && (result = i, true)) || ...);
+            return result;
+        } (std::make_index_sequence<Names::size> {});
+    }
+};
+
+template <class Names>
+struct PerfectHashMatch {
+    static_assert(has_string_names_v<Names>, "PerfectHashMatch requires names convertible to std::string_view");
+    using index_type = index_type_t<Names::size>;
+
+    struct Parameters {
+        std::size_t size;
+        std::uint64_t seed;
+    };
+
+    static constexpr std::size_t max_seeds = 256;
+
+    static constexpr std::size_t slot(std::uint64_t fingerprint, std::uint64_t seed, std::size_t size) {
+        return mix(fingerprint ^ (seed * 0x9e3779b97f4a7c15ull)) & (size - 1);
+    }
+
+    static constexpr bool is_perfect(std::size_t size, std::uint64_t seed) {
+        std::vector<bool> used(size);
+        for (std::size_t i = 0; i < Names::size; ++i) {
+            if (!is_first_name<Names>(i)) {
+                continue;
+            }
+            const std::size_t n = slot(fingerprint_names_v<Names>[i], seed, size);
+            if (used[n]) {
+                return false;
+            }
+            used[n] = true;
+        }
+        return true;
+    }
+
+    static constexpr Parameters find_parameters() {
+        for (std::size_t size = std::bit_ceil(std::max<std::size_t>(Names::size * 2, 2)); ; size *= 2) {
+            for (std::uint64_t seed = 0; seed < max_seeds; ++seed) {
+                if (is_perfect(size, seed)) {
+                    return Parameters {size, seed};
+                }
+            }
+        }
+    }
+
+    static constexpr Parameters parameters = find_parameters();
+
+    static constexpr std::array<index_type, parameters.size> table = [] {
+        std::array<index_type, parameters.size> result {};
+        result.fill(static_cast<index_type>(Names::size));
+        for (std::size_t i = Names::size; i > 0; --i) {
+            result[slot(fingerprint_names_v<Names>[i - 1], parameters.seed, parameters.size)] = static_cast<index_type>(i - 1);
+        }
+        return result;
+    } ();
+
+    template <class T>
+    static constexpr std::size_t find(const T& token) {
+        const std::uint64_t value = fingerprint(token);
+        const std::size_t index = table[slot(value, parameters.seed, parameters.size)];
+        return index < Names::size && fingerprint_names_v<Names>[index] == value
+            && string_names_v<Names>[index] == std::string_view(token) ? index : Names::size;
+    }
+};
+
+template <class Names>
+struct DecisionTreeMatch {
+    static_assert(has_string_names_v<Names>, "DecisionTreeMatch requires names convertible to std::string_view");
+
+    static constexpr std::size_t length_position = static_cast<std::size_t>(-1);
+
+    struct Node {
+        std::size_t position = length_position;
+        std::size_t begin = 0;
+        std::size_t end = 0;
+        std::size_t index = Names::size;
+    };
+
+    struct Edge {
+        std::size_t key = 0;
+        std::size_t node = 0;
+    };
+
+    struct Tree {
+        std::vector<Node> nodes;
+        std::vector<Edge> edges;
+    };
+
+    static constexpr std::size_t key(std::string_view value, std::size_t position) {
+        return position == length_position ? value.size() : static_cast<unsigned char>(value[position]);
+    }
+
+    static constexpr std::size_t distinct_keys(const std::vector<std::size_t>& group, std::size_t position) {
+        std::array<bool, 256> seen {};
+        std::size_t result = 0;
+        for (const std::size_t i : group) {
+            const std::size_t k = key(string_names_v<Names>[i], position);
+            result += !seen[k];
+            seen[k] = true;
+        }
+        return result;
+    }
+
+    static constexpr std::size_t best_position(const std::vector<std::size_t>& group) {
+        std::size_t result = 0;
+        std::size_t max = 0;
+        for (std::size_t position = 0; position < string_names_v<Names>[group.front()].size(); ++position) {
+            if (const std::size_t n = distinct_keys(group, position); n > max) {
+                result = position;
+                max = n;
+            }
+        }
+        return result;
+    }
+
+    static constexpr Tree build() {
+        const auto& names = string_names_v<Names>;
+        Tree tree;
+        std::vector<std::vector<std::size_t>> groups(1);
+        for (std::size_t i = 0; i < Names::size; ++i) {
+            if (is_first_name<Names>(i)) {
+                groups.front().push_back(i);
+            }
+        }
+        tree.nodes.emplace_back();
+        for (std::size_t n = 0; n < tree.nodes.size(); ++n) {
+            const std::vector<std::size_t> group = groups[n];
+            if (n != 0 && group.size() == 1) {
+                tree.nodes[n].index = group.front();
+                continue;
+            }
+            const std::size_t position = n == 0 ? length_position : best_position(group);
+            std::vector<std::size_t> keys;
+            for (const std::size_t i : group) {
+                keys.push_back(key(names[i], position));
+            }
+            std::sort(keys.begin(), keys.end());
+            keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+            tree.nodes[n].position = position;
+            tree.nodes[n].begin = tree.edges.size();
+            for (const std::size_t k : keys) {
+                tree.edges.push_back(Edge {k, tree.nodes.size()});
+                tree.nodes.emplace_back();
+                std::vector<std::size_t> child;
+                for (const std::size_t i : group) {
+                    if (key(names[i], position) == k) {
+                        child.push_back(i);
+                    }
+                }
+                groups.push_back(std::move(child));
+            }
+            tree.nodes[n].end = tree.edges.size();
+        }
+        return tree;
+    }
+
+    static constexpr std::array<Node, build().nodes.size()> nodes = [] {
+        std::array<Node, build().nodes.size()> result;
+        std::ranges::copy(build().nodes, result.begin());
+        return result;
+    } ();
+
+    static constexpr std::array<Edge, build().edges.size()> edges = [] {
+        std::array<Edge, build().edges.size()> result;
+        std::ranges::copy(build().edges, result.begin());
+        return result;
+    } ();
+
+    static constexpr std::size_t find(std::string_view token) {
+        std::size_t node = 0;
+        while (nodes[node].begin != nodes[node].end) {
+            const std::size_t k = key(token, nodes[node].position);
+            std::size_t edge = nodes[node].begin;
+            while (edge != nodes[node].end && edges[edge].key < k) {
+                ++edge;
+            }
+            if (edge == nodes[node].end || edges[edge].key != k) {
+                return Names::size;
+            }
+            node = edges[edge].node;
+        }
+        const std::size_t index = nodes[node].index;
+        return index < Names::size && equal(packed_names_v<Names>[index], string_names_v<Names>[index], token)
+            ? index : Names::size;
+    }
+};
+
+template <class Names>
+struct VectorMatch {
+    static_assert(has_string_names_v<Names>, "VectorMatch requires names convertible to std::string_view");
+
+    static constexpr std::size_t lanes = 32;
+
+    static constexpr std::size_t slots = (Names::size + lanes - 1) / lanes * lanes;
+
+    static constexpr std::uint8_t unmatched_size = 255;
+
+    using Column = std::array<std::uint8_t, slots>;
+
+    static constexpr Column make_column(auto&& get) {
+        Column result {};
+        result.fill(0);
+        for (std::size_t i = 0; i < Names::size; ++i) {
+            result[i] = get(string_names_v<Names>[i]);
+        }
+        return result;
+    }
+
+    alignas(lanes) static constexpr Column sizes = [] {
+        Column result = make_column([] (std::string_view name) {
+            return static_cast<std::uint8_t>(std::min<std::size_t>(name.size(), unmatched_size));
+        });
+        std::fill(result.begin() + Names::size, result.end(), unmatched_size);
+        return result;
+    } ();
+
+    alignas(lanes) static constexpr Column firsts = make_column([] (std::string_view name) {
+        return static_cast<std::uint8_t>(name.empty() ? 0 : name.front());
+    });
+
+    alignas(lanes) static constexpr Column lasts = make_column([] (std::string_view name) {
+        return static_cast<std::uint8_t>(name.empty() ? 0 : name.back());
+    });
+
+    static std::uint32_t match_block(std::size_t offset, std::uint8_t size, std::uint8_t first, std::uint8_t last) {
+#if defined(__AVX2__)
+        const auto column = [&] (const Column& values, std::uint8_t value) {
+            return _mm256_cmpeq_epi8(
+                _mm256_load_si256(reinterpret_cast<const __m256i*>(values.data() + offset)),
+                _mm256_set1_epi8(static_cast<char>(value))
+            );
+        };
+        return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(
+            _mm256_and_si256(column(sizes, size), column(firsts, first)),
+            column(lasts, last)
+        )));
+#elif defined(__SSE2__)
+        std::uint32_t result = 0;
+        for (std::size_t half = 0; half < lanes; half += 16) {
+            const auto column = [&] (const Column& values, std::uint8_t value) {
+                return _mm_cmpeq_epi8(
+                    _mm_load_si128(reinterpret_cast<const __m128i*>(values.data() + offset + half)),
+                    _mm_set1_epi8(static_cast<char>(value))
+                );
+            };
+            result |= static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_and_si128(
+                _mm_and_si128(column(sizes, size), column(firsts, first)),
+                column(lasts, last)
+            ))) << half;
+        }
+        return result;
+#else
+        std::uint32_t result = 0;
+        for (std::size_t i = 0; i < lanes; ++i) {
+            const bool matched = sizes[offset + i] == size && firsts[offset + i] == first && lasts[offset + i] == last;
+            result |= std::uint32_t(matched) << i;
+        }
+        return result;
+#endif
+    }
+
+    static std::size_t find(std::string_view token) {
+        if (token.size() >= unmatched_size) {
+            return LinearMatch<Names>::find_string(token);
+        }
+        const auto size = static_cast<std::uint8_t>(token.size());
+        const auto first = static_cast<std::uint8_t>(token.empty() ? 0 : token.front());
+        const auto last = static_cast<std::uint8_t>(token.empty() ? 0 : token.back());
+        for (std::size_t offset = 0; offset < slots; offset += lanes) {
+            for (std::uint32_t mask = match_block(offset, size, first, last); mask != 0; mask &= mask - 1) {
+                const std::size_t index = offset + std::countr_zero(mask);
+                if (equal(packed_names_v<Names>[index], string_names_v<Names>[index], token)) {
+                    return index;
+                }
+            }
+        }
+        return Names::size;
+    }
+};
+
+template <class Names, std::uint32_t period = 1024>
+struct AdaptiveMatch {
+    static_assert(has_string_names_v<Names>, "AdaptiveMatch requires names convertible to std::string_view");
+
+    using index_type = index_type_t<Names::size>;
+
+    static constexpr std::size_t distinct = distinct_names_v<Names>;
+
+    struct Counters {
+        std::array<index_type, distinct> order = first_names_v<Names>;
+        std::array<std::uint32_t, distinct> hits {};
+        std::uint32_t lookups = 0;
+
+        void reorder() {
+            for (std::size_t i = 1; i < distinct; ++i) {
+                for (std::size_t j = i; j > 0 && hits[j - 1] < hits[j]; --j) {
+                    std::swap(hits[j - 1], hits[j]);
+                    std::swap(order[j - 1], order[j]);
+                }
+            }
+            for (std::uint32_t& v : hits) {
+                v /= 2;
+            }
+            lookups = 0;
+        }
+    };
+
+    static Counters& counters() {
+        thread_local Counters result;
+        return result;
+    }
+
+    template <class F>
+    static std::size_t probe(const F& matches) {
+        Counters& current = counters();
+        for (std::size_t position = 0; position < distinct; ++position) {
+            const std::size_t index = current.order[position];
+            if (matches(index)) {
+                ++current.hits[position];
+                if (++current.lookups == period) {
+                    current.reorder();
+                }
+                return index;
+            }
+        }
+        return Names::size;
+    }
+
+    template <class T>
+    static std::size_t find(const T& token) {
+        return with_string_matcher<Names>(token, [] (const auto& matches) { return probe(matches); });
+    }
+};
+
+template <class Names>
+struct IntegralMatch {
+    static_assert(has_integral_names_v<Names>, "IntegralMatch requires integer names");
+
+    using value_type = typename IntegralNames<Names>::value_type;
+
+    using unsigned_type = std::make_unsigned_t<value_type>;
+
+    using index_type = index_type_t<Names::size>;
+
+    struct Entry {
+        value_type value;
+        std::size_t index;
+    };
+
+    static constexpr std::vector<Entry> sorted() {
+        std::vector<Entry> result;
+        for (std::size_t i = 0; i < Names::size; ++i) {
+            result.push_back(Entry {IntegralNames<Names>::values[i], i});
+        }
+        std::ranges::sort(result, [] (const Entry& lhs, const Entry& rhs) {
+            return lhs.value < rhs.value || (lhs.value == rhs.value && lhs.index < rhs.index);
+        });
+        const auto [first, last] = std::ranges::unique(result, {}, &Entry::value);
+        result.erase(first, last);
+        return result;
+    }
+
+    static constexpr std::size_t distinct = sorted().size();
+
+    static constexpr std::array<value_type, distinct> keys = [] {
+        std::array<value_type, distinct> result {};
+        std::ranges::transform(sorted(), result.begin(), &Entry::value);
+        return result;
+    } ();
+
+    static constexpr std::array<index_type, distinct> indices = [] {
+        std::array<index_type, distinct> result {};
+        std::ranges::transform(sorted(), result.begin(), [] (const Entry& v) { return static_cast<index_type>(v.index); });
+        return result;
+    } ();
+
+    static constexpr unsigned_type range = static_cast<unsigned_type>(keys.back()) - static_cast<unsigned_type>(keys.front());
+
+    static constexpr bool dense = range < 4 * distinct;
+
+    static constexpr std::array<index_type, dense ? std::size_t(range) + 1 : 0> table = [] {
+        std::array<index_type, dense ? std::size_t(range) + 1 : 0> result {};
+        result.fill(static_cast<index_type>(Names::size));
+        for (std::size_t i = 0; i < distinct; ++i) {
+            result[static_cast<unsigned_type>(keys[i]) - static_cast<unsigned_type>(keys.front())] = indices[i];
+        }
+        return result;
+    } ();
+
+    static constexpr std::size_t find_dense(value_type value) {
+        const unsigned_type offset = static_cast<unsigned_type>(value) - static_cast<unsigned_type>(keys.front());
+        return offset <= range ? table[offset] : Names::size;
+    }
+
+    static constexpr std::size_t find_sparse(value_type value) {
+        const value_type* base = keys.data();
+        for (std::size_t size = distinct; size > 1; size -= size / 2) {
+            base = base[size / 2] <= value ? base + size / 2 : base;
+        }
+        return *base == value ? indices[base - keys.data()] : Names::size;
+    }
+
+    template <class T>
+    static constexpr std::size_t find(const T& token) {
+        if constexpr (!is_integer_v<T>) {
+            return LinearMatch<Names>::find(token);
+        } else {
+            if (!std::in_range<value_type>(token)) {
+                return Names::size;
+            }
+            if constexpr (dense) {
+                return find_dense(static_cast<value_type>(token));
+            } else {
+                return find_sparse(static_cast<value_type>(token));
+            }
+        }
+    }
+};
+
+template <class Names>
+struct Prefilter {
+    static_assert(has_string_names_v<Names>, "Prefilter requires names convertible to std::string_view");
+
+    static constexpr std::size_t max_size = 63;
+
+    static constexpr std::uint64_t bit(std::size_t value) {
+        return std::uint64_t(1) << (value & 63);
+    }
+
+    static constexpr std::uint64_t sizes = [] {
+        std::uint64_t result = 0;
+        for (const std::string_view name : string_names_v<Names>) {
+            result |= bit(std::min(name.size(), max_size));
+        }
+        return result;
+    } ();
+
+    static constexpr std::array<std::uint64_t, 4> firsts = [] {
+        std::array<std::uint64_t, 4> result {};
+        for (const std::string_view name : string_names_v<Names>) {
+            if (!name.empty()) {
+                result[static_cast<unsigned char>(name.front()) >> 6] |= bit(static_cast<unsigned char>(name.front()));
+            }
+        }
+        return result;
+    } ();
+
+    static constexpr std::uint64_t bloom = [] {
+        std::uint64_t result = 0;
+        for (const std::uint64_t value : fingerprint_names_v<Names>) {
+            result |= bit(value) | bit(value >> 6);
+        }
+        return result;
+    } ();
+
+    template <class T>
+    static constexpr bool accepts(const T& token) {
+        const std::string_view value(token);
+        if ((sizes & bit(std::min(value.size(), max_size))) == 0) {
+            return false;
+        }
+        if (!value.empty()) {
+            const auto first = static_cast<unsigned char>(value.front());
+            if ((firsts[first >> 6] & bit(first)) == 0) {
+                return false;
+            }
+        }
+        if constexpr (std::is_same_v<T, Token>) {
+            const std::uint64_t mask = bit(token.fingerprint) | bit(token.fingerprint >> 6);
+            return (bloom & mask) == mask;
+        }
+        return true;
+    }
+};
+
+template <class Names, class Match>
+struct PrefilterMatch {
+    template <class T>
+    static constexpr std::size_t find(const T& token) {
+        if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            if (!Prefilter<Names>::accepts(token)) {
+                return Names::size;
+            }
+        }
+        return Match::find(token);
+    }
+};
+
+template <class Names, std::size_t perfect_hash_threshold = 8>
+struct AutoMatch : std::conditional_t<
+    has_integral_names_v<Names>,
+    IntegralMatch<Names>,
+    std::conditional_t<
+        has_string_names_v<Names> && (Names::size > perfect_hash_threshold),
+        PerfectHashMatch<Names>,
+        LinearMatch<Names>
+    >
+> {};
+
+template <class Names, std::size_t perfect_hash_threshold = 8>
+struct PrefilterAutoMatch : std::conditional_t<
+    has_string_names_v<Names>,
+    PrefilterMatch<Names, AutoMatch<Names, perfect_hash_threshold>>,
+    AutoMatch<Names, perfect_hash_threshold>
+> {};
+
+} // namespace router
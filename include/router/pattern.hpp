@@ -0,0 +1,277 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string_view>
+
+namespace router {
+
+inline constexpr std::size_t max_pattern_atoms = 63;
+
+inline constexpr std::size_t max_pattern_states = 64;
+
+enum class Syntax : std::uint8_t {
+    Regex,
+    Glob,
+};
+
+enum class Repeat : std::uint8_t {
+    One,
+    Optional,
+    Star,
+};
+
+struct CharSet {
+    std::array<std::uint64_t, 4> bits {};
+
+    constexpr void add(unsigned char c) {
+        bits[c >> 6] |= std::uint64_t(1) << (c & 63);
+    }
+
+    constexpr void add(unsigned char first, unsigned char last) {
+        for (unsigned c = first; c <= last; ++c) {
+            add(static_cast<unsigned char>(c));
+        }
+    }
+
+    constexpr void invert() {
+        for (std::uint64_t& word : bits) {
+            word = ~word;
+        }
+    }
+
+    constexpr bool contains(unsigned char c) const {
+        return (bits[c >> 6] >> (c & 63)) & 1;
+    }
+
+    static constexpr CharSet any() {
+        CharSet result;
+        result.invert();
+        return result;
+    }
+};
+
+struct Atom {
+    CharSet chars;
+    Repeat repeat = Repeat::One;
+};
+
+[[noreturn]] inline void invalid_pattern(const char*) {
+    std::abort();
+}
+
+inline constexpr std::string_view unsupported_regex = "()|{}^$";
+
+template <std::size_t n>
+struct Atoms {
+    std::array<Atom, n> values {};
+    std::size_t size = 0;
+
+    constexpr void push(const CharSet& chars, Repeat repeat = Repeat::One) {
+        if (size == values.size() || size == max_pattern_atoms) {
+            invalid_pattern("pattern is too long");
+        }
+        values[size++] = Atom {chars, repeat};
+    }
+};
+
+inline constexpr unsigned char escaped(char c) {
+    if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')) {
+        invalid_pattern("unsupported escape sequence, only punctuation can be escaped");
+    }
+    return static_cast<unsigned char>(c);
+}
+
+inline constexpr std::size_t parse_class(std::string_view source, std::size_t position, CharSet& result) {
+    const bool negative = position < source.size() && source[position] == '^';
+    position += negative;
+    bool first = true;
+    while (position < source.size() && (first || source[position] != ']')) {
+        first = false;
+        auto c = static_cast<unsigned char>(source[position++]);
+        if (c == '\\' && position < source.size()) {
+            c = escaped(source[position++]);
+        }
+        if (position + 1 < source.size() && source[position] == '-' && source[position + 1] != ']') {
+            const auto last = static_cast<unsigned char>(source[position + 1]);
+            if (last < c) {
+                invalid_pattern("character range is reversed");
+            }
+            result.add(c, last);
+            position += 2;
+        } else {
+            result.add(c);
+        }
+    }
+    if (position == source.size()) {
+        invalid_pattern("character class is not closed");
+    }
+    if (negative) {
+        result.invert();
+    }
+    return position + 1;
+}
+
+template <std::size_t n>
+inline constexpr Atoms<n> parse_regex(std::string_view source) {
+    Atoms<n> result;
+    std::size_t position = 0;
+    while (position < source.size()) {
+        const char c = source[position++];
+        if (c == '*' || c == '+' || c == '?') {
+            if (result.size == 0 || result.values[result.size - 1].repeat != Repeat::One) {
+                invalid_pattern("quantifier does not follow an atom");
+            }
+            Atom& last = result.values[result.size - 1];
+            if (c == '+') {
+                result.push(last.chars, Repeat::Star);
+            } else {
+                last.repeat = c == '*' ? Repeat::Star : Repeat::Optional;
+            }
+            continue;
+        }
+        if (unsupported_regex.find(c) != std::string_view::npos) {
+            invalid_pattern("unsupported regex metacharacter, escape it to match literally");
+        }
+        CharSet chars;
+        if (c == '.') {
+            chars = CharSet::any();
+        } else if (c == '[') {
+            position = parse_class(source, position, chars);
+        } else if (c == '\\' && position < source.size()) {
+            chars.add(escaped(source[position++]));
+        } else {
+            chars.add(static_cast<unsigned char>(c));
+        }
+        result.push(chars);
+    }
+    return result;
+}
+
+template <std::size_t n>
+inline constexpr Atoms<n> parse_glob(std::string_view source) {
+    Atoms<n> result;
+    std::size_t position = 0;
+    while (position < source.size()) {
+        const char c = source[position++];
+        CharSet chars;
+        if (c == '*') {
+            result.push(CharSet::any(), Repeat::Star);
+            continue;
+        } else if (c == '?') {
+            chars = CharSet::any();
+        } else if (c == '[') {
+            position = parse_class(source, position, chars);
+        } else if (c == '\\' && position < source.size()) {
+            chars.add(escaped(source[position++]));
+        } else {
+            chars.add(static_cast<unsigned char>(c));
+        }
+        result.push(chars);
+    }
+    return result;
+}
+
+template <std::size_t n>
+struct Pattern {
+    static constexpr std::size_t max_atoms = std::min(2 * n, max_pattern_atoms);
+
+    static constexpr std::size_t max_classes = std::min<std::size_t>(2 * max_atoms + 2, 256);
+
+    std::array<std::uint8_t, 256> classes {};
+    std::array<std::uint8_t, max_pattern_states * max_classes> transitions {};
+    std::uint64_t accepting = 0;
+
+    consteval Pattern(const char (&source)[n], Syntax syntax = Syntax::Regex) {
+        const std::string_view value(source, n - 1);
+        compile(syntax == Syntax::Regex ? parse_regex<max_atoms>(value) : parse_glob<max_atoms>(value));
+    }
+
+    static constexpr std::uint64_t closure(const Atoms<max_atoms>& atoms, std::uint64_t states) {
+        for (std::size_t i = 0; i < atoms.size; ++i) {
+            if ((states >> i & 1) && atoms.values[i].repeat != Repeat::One) {
+                states |= std::uint64_t(1) << (i + 1);
+            }
+        }
+        return states;
+    }
+
+    static constexpr std::uint64_t step(const Atoms<max_atoms>& atoms, std::uint64_t states, unsigned char c) {
+        std::uint64_t result = 0;
+        for (std::size_t i = 0; i < atoms.size; ++i) {
+            if ((states >> i & 1) && atoms.values[i].chars.contains(c)) {
+                result |= std::uint64_t(1) << (atoms.values[i].repeat == Repeat::Star ? i : i + 1);
+            }
+        }
+        return closure(atoms, result);
+    }
+
+    constexpr void compile(const Atoms<max_atoms>& atoms) {
+        std::array<std::uint64_t, max_classes> signatures {};
+        std::array<unsigned char, max_classes> representatives {};
+        std::size_t classes_number = 0;
+        for (unsigned c = 0; c < classes.size(); ++c) {
+            std::uint64_t signature = 0;
+            for (std::size_t i = 0; i < atoms.size; ++i) {
+                signature |= std::uint64_t(atoms.values[i].chars.contains(static_cast<unsigned char>(c))) << i;
+            }
+            const auto found = std::find(signatures.begin(), signatures.begin() + classes_number, signature);
+            if (found == signatures.begin() + classes_number) {
+                if (classes_number == max_classes) {
+                    invalid_pattern("pattern has too many character classes");
+                }
+                signatures[classes_number] = signature;
+                representatives[classes_number++] = static_cast<unsigned char>(c);
+            }
+            classes[c] = static_cast<std::uint8_t>(found - signatures.begin());
+        }
+        std::array<std::uint64_t, max_pattern_states> states {0, closure(atoms, 1)};
+        std::size_t states_number = 2;
+        for (std::size_t state = 1; state < states_number; ++state) {
+            if (states[state] >> atoms.size & 1) {
+                accepting |= std::uint64_t(1) << state;
+            }
+            for (std::size_t c = 0; c < classes_number; ++c) {
+                const std::uint64_t next = step(atoms, states[state], representatives[c]);
+                const auto found = std::find(states.begin(), states.begin() + states_number, next);
+                if (found == states.begin() + states_number) {
+                    if (states_number == max_pattern_states) {
+                        invalid_pattern("pattern has too many states");
+                    }
+                    states[states_number++] = next;
+                }
+                transitions[state * max_classes + c] = static_cast<std::uint8_t>(found - states.begin());
+            }
+        }
+    }
+
+    constexpr bool matches(std::string_view token) const {
+        std::size_t state = 1;
+        for (const char c : token) {
+            state = transitions[state * max_classes + classes[static_cast<unsigned char>(c)]];
+            if (state == 0) {
+                return false;
+            }
+        }
+        return accepting >> state & 1;
+    }
+
+    friend constexpr bool operator ==(const Pattern& pattern, std::string_view token) {
+        return pattern.matches(token);
+    }
+};
+
+template <std::size_t n>
+consteval Pattern<n> regex(const char (&source)[n]) {
+    return Pattern<n>(source, Syntax::Regex);
+}
+
+template <std::size_t n>
+consteval Pattern<n> glob(const char (&source)[n]) {
+    return Pattern<n>(source, Syntax::Glob);
+}
+
+} // namespace router
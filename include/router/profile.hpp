@@ -0,0 +1,238 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <ostream>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <router/match.hpp>
+
+namespace router {
+
+struct ProfileEntry {
+    std::string_view selector;
+    std::string_view name;
+    std::uint64_t hits = 0;
+};
+
+inline constexpr bool is_signature_escaped(char c) {
+    return c == ',' || c == '\\';
+}
+
+template <class Names>
+struct Signature {
+    static constexpr std::size_t size = [] {
+        std::size_t result = Names::size == 0 ? 0 : Names::size - 1;
+        for (const std::string_view name : string_names_v<Names>) {
+            result += name.size() + std::ranges::count_if(name, is_signature_escaped);
+        }
+        return result;
+    } ();
+
+    static constexpr std::array<char, size> chars = [] {
+        std::array<char, size> result {};
+        auto output = result.begin();
+        for (std::size_t i = 0; i < Names::size; ++i) {
+            if (i != 0) {
+                *output++ = ',';
+            }
+            for (const char c : string_names_v<Names>[i]) {
+                if (is_signature_escaped(c)) {
+                    *output++ = '\\';
+                }
+                *output++ = c;
+            }
+        }
+        return result;
+    } ();
+
+    static constexpr std::string_view value {chars.data(), size};
+};
+
+template <class Names>
+inline constexpr std::string_view signature_v = Signature<Names>::value;
+
+struct Recorded {
+    std::string_view selector;
+    const std::string_view* names;
+    const std::atomic<std::uint64_t>* hits;
+    std::size_t size;
+};
+
+struct Recordings {
+    std::mutex mutex;
+    std::vector<Recorded> values;
+
+    static Recordings& instance() {
+        static Recordings result;
+        return result;
+    }
+
+    bool add(const Recorded& value) {
+        const std::lock_guard lock(mutex);
+        values.push_back(value);
+        return true;
+    }
+};
+
+template <class Names, class Match = AutoMatch<Names>>
+struct RecordingMatch {
+    static_assert(has_string_names_v<Names>, "RecordingMatch requires names convertible to std::string_view");
+
+    static inline std::array<std::atomic<std::uint64_t>, Names::size> hits {};
+
+    static inline const bool registered = Recordings::instance().add(
+        Recorded {signature_v<Names>, string_names_v<Names>.data(), hits.data(), Names::size}
+    );
+
+    template <class T>
+    static std::size_t find(const T& token) {
+        (void) registered;
+        const std::size_t index = Match::find(token);
+        if (index < Names::size) {
+            hits[index].fetch_add(1, std::memory_order_relaxed);
+        }
+        return index;
+    }
+};
+
+inline void write_literal(std::ostream& stream, std::string_view value) {
+    stream << '"';
+    for (const char c : value) {
+        const auto byte = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\' || byte < 0x20 || byte > 0x7e) {
+            char escaped[5];
+            std::snprintf(escaped, sizeof(escaped), "\\%03o", byte);
+            stream << escaped;
+        } else {
+            stream << c;
+        }
+    }
+    stream << '"';
+}
+
+inline std::vector<ProfileEntry> collect_profile() {
+    Recordings& recordings = Recordings::instance();
+    const std::lock_guard lock(recordings.mutex);
+    std::vector<ProfileEntry> result;
+    for (const Recorded& recorded : recordings.values) {
+        for (std::size_t i = 0; i < recorded.size; ++i) {
+            const auto found = std::ranges::find_if(result, [&] (const ProfileEntry& entry) {
+                return entry.selector == recorded.selector && entry.name == recorded.names[i];
+            });
+            const std::uint64_t hits = recorded.hits[i].load(std::memory_order_relaxed);
+            if (found == result.end()) {
+                result.push_back(ProfileEntry {recorded.selector, recorded.names[i], hits});
+            } else {
+                found->hits += hits;
+            }
+        }
+    }
+    return result;
+}
+
+inline void write_profile(std::ostream& stream, std::string_view variable) {
+    const std::vector<ProfileEntry> profile = collect_profile();
+    stream << "#pragma once\n\n#include <array>\n\n#include <router/profile.hpp>\n\n"
+        << "inline constexpr std::array<router::ProfileEntry, " << profile.size() << "> " << variable << " {{\n";
+    for (const ProfileEntry& entry : profile) {
+        stream << "    {";
+        write_literal(stream, entry.selector);
+        stream << ", ";
+        write_literal(stream, entry.name);
+        stream << ", " << entry.hits << "},\n";
+    }
+    stream << "}};\n";
+}
+
+template <class Names, const auto& profile>
+struct ProfiledMatch {
+    static_assert(has_string_names_v<Names>, "ProfiledMatch requires names convertible to std::string_view");
+
+    using index_type = index_type_t<Names::size>;
+
+    static constexpr std::size_t distinct = distinct_names_v<Names>;
+
+    static constexpr std::uint64_t hits(std::size_t index) {
+        for (const ProfileEntry& entry : profile) {
+            if (entry.selector == signature_v<Names> && entry.name == string_names_v<Names>[index]) {
+                return entry.hits;
+            }
+        }
+        return 0;
+    }
+
+    static constexpr std::array<index_type, distinct> order = [] {
+        std::array<index_type, distinct> result = first_names_v<Names>;
+        std::ranges::sort(result, [] (std::size_t lhs, std::size_t rhs) {
+            return hits(lhs) > hits(rhs) || (hits(lhs) == hits(rhs) && lhs < rhs);
+        });
+        return result;
+    } ();
+
+    static constexpr std::uint64_t total = [] {
+        std::uint64_t result = 0;
+        for (const std::size_t index : order) {
+            result += hits(index);
+        }
+        return result;
+    } ();
+
+    static constexpr std::size_t likely_number = std::ranges::count_if(order, [] (std::size_t index) {
+        return hits(index) > 0 && hits(index) * distinct >= total;
+    });
+
+    static constexpr std::size_t hot_number = std::ranges::count_if(order, [] (std::size_t index) {
+        return hits(index) > 0;
+    });
+
+    template <std::size_t position, class F>
+    static constexpr bool probe_likely(const F& matches, std::size_t& result) {
+        if (matches(order[position])) [[likely]] {
+            result = order[position];
+            return true;
+        }
+        return false;
+    }
+
+    template <class F>
+    static std::size_t find_cold(const F& matches) {
+        for (std::size_t position = hot_number; position < distinct; ++position) {
+            if (matches(order[position])) {
+                return order[position];
+            }
+        }
+        return Names::size;
+    }
+
+    template <class F>
+    static std::size_t probe(const F& matches) {
+        std::size_t result = Names::size;
+        const bool found = [&] <std::size_t ... position> (std::index_sequence<position ...>) {
+            return (probe_likely<position>(matches, result) || ...);
+        } (std::make_index_sequence<likely_number>());
+        if (found) {
+            return result;
+        }
+        for (std::size_t position = likely_number; position < hot_number; ++position) {
+            if (matches(order[position])) {
+                return order[position];
+            }
+        }
+        return find_cold(matches);
+    }
+
+    template <class T>
+    static std::size_t find(const T& token) {
+        return with_string_matcher<Names>(token, [] (const auto& matches) { return probe(matches); });
+    }
+};
+
+} // namespace router
@@ -1,15 +1,33 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <exception>
 #include <functional>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <optional>
 #include <ranges>
-#include <stdexcept>
+#include <string_view>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 #include <variant>
 
+#if __has_include(<expected>)
+#include <expected>
+#endif
+
 #include <tl/expected.hpp>
 
+#include <router/match.hpp>
+
 namespace router {
 
 template <class Tag, class F>
@@ -22,7 +40,8 @@ struct Action {
     constexpr explicit Action(Tag, T&& f) : f(std::forward<T>(f)) {}
 
     template <class ... Args>
-    auto operator ()(Args&& ... args) const -> std::invoke_result_t<F, Args&& ...> {
+    auto operator ()(Args&& ... args) const noexcept(std::is_nothrow_invocable_v<const F&, Args&& ...>)
+        -> std::invoke_result_t<F, Args&& ...> {
         return std::invoke(f, std::forward<Args>(args) ...);
     }
 };
@@ -35,16 +54,16 @@ struct ArgumentsNumber {
     static constexpr std::size_t value = ArgumentsNumber<decltype(&F::operator())>::value - 1;
 };
 
-template <class R, class ... Args>
-struct ArgumentsNumber<R (*)(Args ...)>
+template <class R, bool nothrow, class ... Args>
+struct ArgumentsNumber<R (*)(Args ...) noexcept(nothrow)>
     : std::integral_constant<std::size_t, sizeof ... (Args)> {};
 
-template <class T, class R, class ... Args>
-struct ArgumentsNumber<R (T::*)(Args ...)>
+template <class T, class R, bool nothrow, class ... Args>
+struct ArgumentsNumber<R (T::*)(Args ...) noexcept(nothrow)>
     : std::integral_constant<std::size_t, sizeof ... (Args) + 1> {};
 
-template <class T, class R, class ... Args>
-struct ArgumentsNumber<R (T::*)(Args ...) const>
+template <class T, class R, bool nothrow, class ... Args>
+struct ArgumentsNumber<R (T::*)(Args ...) const noexcept(nothrow)>
     : std::integral_constant<std::size_t, sizeof ... (Args) + 1> {};
 
 template <class Tag, class F>
@@ -53,23 +72,54 @@ struct ArgumentsNumber<Action<Tag, F>> : ArgumentsNumber<F> {};
 template <class F>
 inline constexpr std::size_t arguments_number_v = ArgumentsNumber<F>::value;
 
+template <class F>
+struct ArgumentTypes {
+    using type = typename ArgumentTypes<decltype(&F::operator())>::parameters;
+};
+
+template <class R, bool nothrow, class ... Args>
+struct ArgumentTypes<R (*)(Args ...) noexcept(nothrow)> {
+    using type = std::tuple<Args ...>;
+};
+
+template <class T, class R, bool nothrow, class ... Args>
+struct ArgumentTypes<R (T::*)(Args ...) noexcept(nothrow)> {
+    using type = std::tuple<T&, Args ...>;
+    using parameters = std::tuple<Args ...>;
+};
+
+template <class T, class R, bool nothrow, class ... Args>
+struct ArgumentTypes<R (T::*)(Args ...) const noexcept(nothrow)> {
+    using type = std::tuple<const T&, Args ...>;
+    using parameters = std::tuple<Args ...>;
+};
+
+template <class Tag, class F>
+struct ArgumentTypes<Action<Tag, F>> : ArgumentTypes<F> {};
+
+template <class F, std::size_t i>
+using parameter_t = std::tuple_element_t<i, typename ArgumentTypes<F>::type>;
+
+template <class F, std::size_t i>
+using argument_t = std::remove_cvref_t<parameter_t<F, i>>;
+
 template <class F>
 struct ReturnType {
     using type = typename ReturnType<decltype(&F::operator())>::type;
 };
 
-template <class T, class R, class ... Args>
-struct ReturnType<R (T::*)(Args ...)> {
+template <class T, class R, bool nothrow, class ... Args>
+struct ReturnType<R (T::*)(Args ...) noexcept(nothrow)> {
     using type = R;
 };
 
-template <class T, class R, class ... Args>
-struct ReturnType<R (T::*)(Args ...) const> {
+template <class T, class R, bool nothrow, class ... Args>
+struct ReturnType<R (T::*)(Args ...) const noexcept(nothrow)> {
     using type = R;
 };
 
-template <class R, class ... Args>
-struct ReturnType<R (*)(Args ...)> {
+template <class R, bool nothrow, class ... Args>
+struct ReturnType<R (*)(Args ...) noexcept(nothrow)> {
     using type = R;
 };
 
@@ -136,10 +186,316 @@ enum class Errc {
     TooManyArguments,
     NotEnoughInput,
     InvalidAction,
+    InvalidArgument,
+    NotFound,
+};
+
+struct Error {
+    Errc code = Errc::None;
+    std::size_t index = 0;
+    std::size_t depth = 0;
+    std::string_view token;
+
+    constexpr Error(Errc code, std::size_t index = 0, std::size_t depth = 0, std::string_view token = {})
+        : code(code), index(index), depth(depth), token(token) {}
+
+    constexpr operator Errc() const {
+        return code;
+    }
+};
+
+static_assert(std::is_trivially_copyable_v<Error>, "Error must stay trivially copyable");
+
+template <class Reference>
+inline constexpr bool is_stable_token_v = std::is_lvalue_reference_v<Reference>
+    || std::is_pointer_v<std::remove_cvref_t<Reference>>
+    || std::is_same_v<std::remove_cvref_t<Reference>, std::string_view>
+    || std::is_same_v<std::remove_cvref_t<Reference>, Token>;
+
+template <class Reference>
+inline constexpr std::string_view error_token(Reference&& token)
+        noexcept(!is_stable_token_v<Reference&&> || !std::is_convertible_v<decltype(token_value(token)), std::string_view>
+                 || std::is_nothrow_convertible_v<decltype(token_value(token)), std::string_view>) {
+    if constexpr (is_stable_token_v<Reference&&>
+                  && std::is_convertible_v<decltype(token_value(token)), std::string_view>) {
+        return std::string_view(token_value(token));
+    } else {
+        return {};
+    }
+}
+
+template <class T>
+using Result = tl::expected<T, Error>;
+
+struct ExpectedResult {
+    static constexpr bool nothrow = true;
+
+    template <class T>
+    using type = Result<T>;
+
+    template <class F>
+    static constexpr auto make(F&& produce) {
+        return produce();
+    }
+};
+
+#ifdef __cpp_lib_expected
+struct StdExpectedResult {
+    static constexpr bool nothrow = true;
+
+    template <class T>
+    using type = std::expected<T, Error>;
+
+    template <class F>
+    static constexpr auto make(F&& produce) {
+        auto value = produce();
+        using Return = type<typename decltype(value)::value_type>;
+        if (!value) {
+            return Return(std::unexpect, value.error());
+        }
+        if constexpr (std::is_void_v<typename Return::value_type>) {
+            return Return();
+        } else {
+            return Return(std::in_place, std::move(*value));
+        }
+    }
+};
+#endif
+
+struct Exception : std::exception {
+    Error error;
+
+    explicit Exception(const Error& error) : error(error) {}
+
+    const char* what() const noexcept override {
+        switch (error.code) {
+            case Errc::None:
+                break;
+            case Errc::TooManyArguments:
+                return "router: too many arguments";
+            case Errc::NotEnoughInput:
+                return "router: not enough input";
+            case Errc::InvalidAction:
+                return "router: invalid action";
+            case Errc::InvalidArgument:
+                return "router: invalid argument";
+            case Errc::NotFound:
+                return "router: not found";
+        }
+        return "router: error";
+    }
+};
+
+#ifdef __cpp_exceptions
+struct ThrowingResult {
+    static constexpr bool nothrow = false;
+
+    template <class T>
+    using type = T;
+
+    template <class F>
+    static constexpr auto make(F&& produce) {
+        auto value = produce();
+        if (!value) [[unlikely]] {
+            throw Exception(value.error());
+        }
+        if constexpr (!std::is_void_v<typename decltype(value)::value_type>) {
+            return std::move(*value);
+        }
+    }
 };
+#endif
+
+template <class Policy, class = void>
+struct ResultPolicy {
+    using type = ExpectedResult;
+};
+
+template <class Policy>
+struct ResultPolicy<Policy, std::void_t<typename Policy::result>> {
+    using type = typename Policy::result;
+};
+
+template <class Policy>
+using result_policy_t = typename ResultPolicy<Policy>::type;
+
+template <class T, class = void>
+struct Parser {
+    template <class Value>
+    static constexpr T parse(Value&& value) noexcept(std::is_nothrow_constructible_v<T, Value&&>) {
+        return T(std::forward<Value>(value));
+    }
+};
+
+namespace arg {
+
+using i8 = std::int8_t;
+using i16 = std::int16_t;
+using i32 = std::int32_t;
+using i64 = std::int64_t;
+using u8 = std::uint8_t;
+using u16 = std::uint16_t;
+using u32 = std::uint32_t;
+using u64 = std::uint64_t;
+
+} // namespace arg
+
+inline constexpr std::size_t max_digits = std::numeric_limits<std::uint64_t>::digits10 + 1;
+
+inline constexpr std::uint64_t zero_digits = 0x3030303030303030;
+
+inline constexpr bool is_digits(std::uint64_t chunk) {
+    constexpr std::uint64_t high = 0xF0F0F0F0F0F0F0F0;
+    return ((chunk & high) | (((chunk + 0x0606060606060606) & high) >> 4)) == 0x3333333333333333;
+}
+
+inline constexpr std::uint64_t convert_digits(std::uint64_t chunk) {
+    chunk -= zero_digits;
+    chunk = chunk * 10 + (chunk >> 8);
+    return (((chunk & 0x000000FF000000FF) * (100 + (std::uint64_t(1000000) << 32)))
+        + (((chunk >> 16) & 0x000000FF000000FF) * (1 + (std::uint64_t(10000) << 32)))) >> 32;
+}
+
+inline constexpr std::uint64_t load_digits(const char* data, std::size_t size, std::size_t available) {
+    if (available >= 8) {
+        const std::uint64_t chunk = load<std::uint64_t>(data);
+        return size == 8 ? chunk : chunk << (8 * (8 - size)) | zero_digits >> (8 * size);
+    }
+    return std::uint64_t(load<std::uint32_t>(data)) << (8 * (8 - size))
+        | std::uint64_t(load<std::uint32_t>(data + size - 4)) << 32
+        | zero_digits >> (8 * size);
+}
+
+inline constexpr bool parse_digits(std::string_view digits, std::uint64_t& result) {
+    if (digits.size() > max_digits) {
+        const std::size_t zeros = std::min(digits.find_first_not_of('0'), digits.size() - 1);
+        digits.remove_prefix(zeros);
+    }
+    if (digits.empty() || digits.size() > max_digits) {
+        return false;
+    }
+    if (digits.size() < 4) {
+        result = 0;
+        for (const char c : digits) {
+            const auto digit = static_cast<unsigned char>(c - '0');
+            if (digit > 9) {
+                return false;
+            }
+            result = result * 10 + digit;
+        }
+        return true;
+    }
+    if constexpr (std::endian::native != std::endian::little) {
+        result = 0;
+        for (const char c : digits) {
+            if (c < '0' || c > '9' || result > (std::numeric_limits<std::uint64_t>::max() - (c - '0')) / 10) {
+                return false;
+            }
+            result = result * 10 + (c - '0');
+        }
+        return true;
+    }
+    const std::size_t head = (digits.size() - 1) % 8 + 1;
+    const std::uint64_t first = load_digits(digits.data(), head, digits.size());
+    if (!is_digits(first)) {
+        return false;
+    }
+    result = convert_digits(first);
+    for (std::size_t position = head; position < digits.size(); position += 8) {
+        const std::uint64_t chunk = load<std::uint64_t>(digits.data() + position);
+        if (!is_digits(chunk)) {
+            return false;
+        }
+        const std::uint64_t value = convert_digits(chunk);
+        if (result > (std::numeric_limits<std::uint64_t>::max() - value) / 100000000) {
+            return false;
+        }
+        result = result * 100000000 + value;
+    }
+    return true;
+}
 
 template <class T>
-using Result = tl::expected<T, Errc>;
+inline constexpr std::uint64_t magnitude_of(T value) {
+    if constexpr (std::is_signed_v<T>) {
+        if (value < 0) {
+            return static_cast<std::uint64_t>(-(value + 1)) + 1;
+        }
+    }
+    return static_cast<std::uint64_t>(value);
+}
+
+template <class T>
+inline constexpr std::optional<T> parse_integer(std::string_view token, T min = std::numeric_limits<T>::min(),
+                                                T max = std::numeric_limits<T>::max()) {
+    static_assert(is_integer_v<T>, "parse_integer requires an integer type");
+    const bool negative = std::is_signed_v<T> && !token.empty() && token.front() == '-';
+    if (negative) {
+        token.remove_prefix(1);
+    }
+    if (negative ? min > 0 : max < 0) {
+        return std::nullopt;
+    }
+    const std::uint64_t low = negative ? (max < 0 ? magnitude_of(max) : 0) : (min > 0 ? magnitude_of(min) : 0);
+    const std::uint64_t high = negative ? magnitude_of(min) : magnitude_of(max);
+    std::uint64_t magnitude = 0;
+    if (!parse_digits(token, magnitude) || magnitude < low || magnitude > high) {
+        return std::nullopt;
+    }
+    using Unsigned = std::make_unsigned_t<T>;
+    const auto value = static_cast<Unsigned>(magnitude);
+    return static_cast<T>(negative ? static_cast<Unsigned>(Unsigned(0) - value) : value);
+}
+
+template <class T>
+struct Parser<T, std::enable_if_t<is_integer_v<T>>> {
+    template <class Value>
+    static constexpr auto parse(Value&& value)
+        noexcept(std::is_convertible_v<Value&&, std::string_view> || std::is_nothrow_constructible_v<T, Value&&>) {
+        if constexpr (std::is_convertible_v<Value&&, std::string_view>) {
+            return parse_integer<T>(std::string_view(std::forward<Value>(value)));
+        } else {
+            return T(std::forward<Value>(value));
+        }
+    }
+};
+
+template <class T, class Value, class ... Context>
+inline constexpr decltype(auto) parse_value(Value&& value, Context& ... context) {
+    if constexpr (requires { Parser<T>::parse(std::forward<Value>(value), context ...); }) {
+        return Parser<T>::parse(std::forward<Value>(value), context ...);
+    } else {
+        return Parser<T>::parse(std::forward<Value>(value));
+    }
+}
+
+template <class T, class Value, class ... Context>
+inline constexpr Result<T> parse(Value&& value, Context& ... context) {
+    using Parsed = decltype(parse_value<T>(std::forward<Value>(value), context ...));
+    if constexpr (std::is_same_v<Parsed, std::optional<T>>) {
+        std::optional<T> result = parse_value<T>(std::forward<Value>(value), context ...);
+        if (!result) {
+            return tl::make_unexpected(Errc::InvalidArgument);
+        }
+        return std::move(*result);
+    } else {
+        return parse_value<T>(std::forward<Value>(value), context ...);
+    }
+}
+
+template <class T, class Value = std::string_view, class Context = std::tuple<>>
+inline constexpr bool is_nothrow_parse_v = false;
+
+template <class T, class Value, class ... Context>
+inline constexpr bool is_nothrow_parse_v<T, Value, std::tuple<Context ...>> = std::is_nothrow_move_constructible_v<T>
+    && noexcept(error_token(std::declval<Value>()))
+    && [] {
+        if constexpr (requires { Parser<T>::parse(std::declval<Value>(), std::declval<Context&>() ...); }) {
+            return noexcept(Parser<T>::parse(std::declval<Value>(), std::declval<Context&>() ...));
+        } else {
+            return noexcept(Parser<T>::parse(std::declval<Value>()));
+        }
+    } ();
 
 template <class T>
 struct ResultValue {
@@ -154,8 +510,15 @@ struct ResultValue<Result<T>> {
 template <class T>
 using result_value_t = typename ResultValue<T>::type;
 
+template <class T>
+inline constexpr bool is_result_v = !std::is_same_v<result_value_t<T>, T>;
+
 template <class ReturnType>
 struct MakeResult {
+    ReturnType operator ()(ReturnType&& value) const {
+        return std::move(value);
+    }
+
     template <class T>
     ReturnType operator ()(Result<T>&& value) const {
         return std::move(value).and_then(*this);
@@ -175,26 +538,696 @@ struct MakeResult {
     }
 };
 
+template <class T, class Variant>
+struct AlternativeIndex : std::integral_constant<std::size_t, std::variant_npos> {};
+
+template <class T, class ... Ts>
+struct AlternativeIndex<T, std::variant<Ts ...>> : std::integral_constant<std::size_t, [] {
+    constexpr std::array<bool, sizeof ... (Ts)> same {std::is_same_v<T, Ts> ...};
+    const std::size_t index = static_cast<std::size_t>(std::ranges::find(same, true) - same.begin());
+    return index < same.size() ? index : std::variant_npos;
+} ()> {};
+
+template <class T, class Variant>
+inline constexpr std::size_t alternative_index_v = AlternativeIndex<T, Variant>::value;
+
+template <class F>
+struct Lazy {
+    F& f;
+
+    constexpr operator std::invoke_result_t<F&>() const {
+        return f();
+    }
+};
+
+template <class ReturnType>
+struct Emplace {
+    using value_type = typename ReturnType::value_type;
+
+    ReturnType operator ()() const {
+        return ReturnType();
+    }
+
+    template <class T>
+    ReturnType operator ()(T&& value) const {
+        return MakeResult<ReturnType>()(std::forward<T>(value));
+    }
+
+    template <class F>
+    ReturnType emplace(F&& produce) const {
+        using T = std::invoke_result_t<F&>;
+        if constexpr (std::is_void_v<T>) {
+            produce();
+            return ReturnType();
+        } else if constexpr (std::is_same_v<T, ReturnType>) {
+            return produce();
+        } else if constexpr (std::is_trivially_copyable_v<T> && !is_result_v<T>) {
+            return MakeResult<ReturnType>()(produce());
+        } else if constexpr (std::is_same_v<T, value_type>) {
+            return ReturnType(tl::in_place, Lazy<F> {produce});
+        } else if constexpr (alternative_index_v<T, value_type> != std::variant_npos) {
+            return ReturnType(tl::in_place, std::in_place_index<alternative_index_v<T, value_type>>, Lazy<F> {produce});
+        } else {
+            return MakeResult<ReturnType>()(produce());
+        }
+    }
+};
+
+template <class T>
+struct IsEmplace : std::false_type {};
+
+template <class ReturnType>
+struct IsEmplace<Emplace<ReturnType>> : std::true_type {};
+
+template <class T>
+inline constexpr bool is_emplace_v = IsEmplace<std::remove_cv_t<T>>::value;
+
+template <class Policy, class ... Actions>
+struct BasicSelector;
+
+template <class Policy, class T, class ... Actions>
+struct BasicArgument;
+
+template <class T>
+struct IsSelector {
+    template <class Policy, class ... Actions>
+    static std::true_type test(const BasicSelector<Policy, Actions ...>*);
+
+    static std::false_type test(const void*);
+
+    static constexpr bool value = decltype(test(std::declval<T*>()))::value;
+};
+
+template <class T>
+inline constexpr bool is_selector_v = IsSelector<T>::value;
+
+template <class T>
+struct IsArgument {
+    template <class Policy, class Value, class ... Actions>
+    static std::true_type test(const BasicArgument<Policy, Value, Actions ...>*);
+
+    static std::false_type test(const void*);
+
+    static constexpr bool value = decltype(test(std::declval<T*>()))::value;
+};
+
+template <class T>
+inline constexpr bool is_argument_v = IsArgument<T>::value;
+
+template <class T>
+struct IsNode : std::bool_constant<is_selector_v<T> || is_argument_v<T>> {};
+
+template <class Tag, class F>
+struct IsNode<Action<Tag, F>> : IsNode<F> {};
+
+template <class T>
+inline constexpr bool is_node_v = IsNode<T>::value;
+
+template <class T>
+struct Parsed {
+    Result<T> value;
+};
+
+template <class T>
+struct IsParsed : std::false_type {};
+
+template <class T>
+struct IsParsed<Parsed<T>> : std::true_type {};
+
+template <class T>
+inline constexpr bool is_parsed_v = IsParsed<std::remove_cvref_t<T>>::value;
+
+template <class T, class Value, class Context>
+inline constexpr Parsed<T> parse_at(Value&& value, std::size_t index, const Context& context) {
+    Result<T> result = std::apply([&] (auto& ... context) {
+        return parse<T>(std::forward<Value>(value), context ...);
+    }, context);
+    if (!result) {
+        const Errc code = result.error().code == Errc::None ? Errc::InvalidArgument : result.error().code;
+        result = tl::make_unexpected(Error {code, index, 0, error_token(std::forward<Value>(value))});
+    }
+    return Parsed<T> {std::move(result)};
+}
+
+template <class Parameter, class Value>
+inline constexpr bool binds_token_v = std::is_reference_v<Parameter>
+    && std::is_same_v<std::remove_cvref_t<Value>, std::remove_cvref_t<Parameter>>
+    && std::is_convertible_v<Value&&, Parameter>;
+
+template <class Parameter, class Value, class Context>
+inline constexpr decltype(auto) bind_at(Value&& value, std::size_t index, const Context& context) {
+    if constexpr (binds_token_v<Parameter, Value>) {
+        return std::forward<Value>(value);
+    } else {
+        return parse_at<std::remove_cvref_t<Parameter>>(std::forward<Value>(value), index, context);
+    }
+}
+
+template <class T, class Iterator>
+struct Deferred {
+    using value_type = T;
+
+    Iterator token;
+
+    template <class First, class Context>
+    constexpr Parsed<T> parse(const First& first, const Context& context) const {
+        std::size_t behind = 0;
+        if constexpr (std::sentinel_for<First, Iterator>) {
+            behind = static_cast<std::size_t>(std::ranges::distance(token, first));
+        }
+        return parse_at<T>(token_value(*token), std::size_t(0) - behind, context);
+    }
+};
+
+template <class T, class Iterator>
+inline constexpr Deferred<T, std::decay_t<Iterator>> defer(Iterator&& token) {
+    return Deferred<T, std::decay_t<Iterator>> {std::forward<Iterator>(token)};
+}
+
+template <class T>
+struct IsDeferred : std::false_type {};
+
+template <class T, class Iterator>
+struct IsDeferred<Deferred<T, Iterator>> : std::true_type {};
+
+template <class T>
+inline constexpr bool is_deferred_v = IsDeferred<std::remove_cvref_t<T>>::value;
+
+template <class T>
+struct Resolved {
+    using type = T;
+};
+
+template <class T>
+    requires is_deferred_v<T>
+struct Resolved<T> {
+    using type = typename std::remove_cvref_t<T>::value_type;
+};
+
+template <class T>
+using resolved_t = typename Resolved<T>::type;
+
+template <class T>
+inline constexpr auto context_of(T& value) {
+    if constexpr (is_deferred_v<T>) {
+        return std::tuple<>();
+    } else {
+        return std::tuple<T&>(value);
+    }
+}
+
+template <class ... Args>
+inline constexpr auto make_context(Args& ... args) {
+    return std::tuple_cat(context_of(args) ...);
+}
+
+template <class First, class Context, class T>
+inline constexpr decltype(auto) hold(const First& first, const Context& context, T&& value) {
+    if constexpr (is_deferred_v<T>) {
+        return value.parse(first, context);
+    } else {
+        return std::forward<T>(value);
+    }
+}
+
+template <class T>
+inline constexpr decltype(auto) unwrap(T&& value) {
+    if constexpr (is_parsed_v<T>) {
+        return *std::move(value.value);
+    } else {
+        return std::forward<T>(value);
+    }
+}
+
+template <class T>
+inline constexpr bool failed(const T& value, Error& error) {
+    if constexpr (is_parsed_v<T>) {
+        if (!value.value) {
+            error = value.value.error();
+            return true;
+        }
+    }
+    return false;
+}
+
+template <class Action, class ... Held>
+inline auto call(const Action& action, Held&& ... held)
+        -> Result<result_value_t<decltype(action(unwrap(std::forward<Held>(held)) ...))>> {
+    using Value = decltype(action(unwrap(std::forward<Held>(held)) ...));
+    using Return = Result<result_value_t<Value>>;
+    Error error {Errc::None};
+    if ((failed(held, error) || ...)) {
+        return tl::make_unexpected(error);
+    }
+    if constexpr (std::is_void_v<Value>) {
+        action(unwrap(std::forward<Held>(held)) ...);
+        return {};
+    } else if constexpr (std::is_same_v<Value, Return> || !is_result_v<Value>) {
+        return action(unwrap(std::forward<Held>(held)) ...);
+    } else {
+        return MakeResult<Return>()(action(unwrap(std::forward<Held>(held)) ...));
+    }
+}
+
+template <class T>
+struct Rest {
+    static constexpr std::size_t storage_size = 8 * sizeof(void*);
+
+    template <class Iterator>
+    static constexpr bool is_inline_v = sizeof(Iterator) <= storage_size
+        && alignof(Iterator) <= alignof(std::max_align_t)
+        && std::is_nothrow_copy_constructible_v<Iterator>;
+
+    struct Operations {
+        void (*increment)(void*);
+        Result<T> (*parse)(const void*, std::size_t);
+        void (*copy)(const void*, void*);
+        void (*destroy)(void*);
+    };
+
+    template <class Iterator>
+    static Iterator& get(void* storage) {
+        if constexpr (is_inline_v<Iterator>) {
+            return *std::launder(static_cast<Iterator*>(storage));
+        } else {
+            return **static_cast<Iterator**>(storage);
+        }
+    }
+
+    template <class Iterator>
+    static const Iterator& get(const void* storage) {
+        return get<Iterator>(const_cast<void*>(storage));
+    }
+
+    template <class Iterator>
+    static void construct(const Iterator& it, void* storage) {
+        if constexpr (is_inline_v<Iterator>) {
+            new (storage) Iterator(it);
+        } else {
+            *static_cast<Iterator**>(storage) = new Iterator(it);
+        }
+    }
+
+    template <class Iterator>
+    static constexpr bool is_trivial_v = is_inline_v<Iterator> && std::is_trivially_copyable_v<Iterator>;
+
+    template <class Iterator>
+    static constexpr Operations operations {
+        [] (void* it) {
+            ++get<Iterator>(it);
+        },
+        [] (const void* it, std::size_t index) {
+            return parse_at<T>(token_value(*get<Iterator>(it)), index, std::tuple<>()).value;
+        },
+        is_trivial_v<Iterator> ? nullptr : +[] (const void* from, void* to) {
+            construct(get<Iterator>(from), to);
+        },
+        is_trivial_v<Iterator> ? nullptr : +[] (void* it) {
+            if constexpr (is_inline_v<Iterator>) {
+                get<Iterator>(it).~Iterator();
+            } else {
+                delete &get<Iterator>(it);
+            }
+        },
+    };
+
+    struct iterator {
+        using value_type = Result<T>;
+        using difference_type = std::ptrdiff_t;
+
+        const Operations* operations = nullptr;
+        std::size_t index = 0;
+        std::size_t size = 0;
+        alignas(std::max_align_t) std::byte storage[storage_size] {};
+
+        iterator() = default;
+
+        template <class Iterator>
+        iterator(const Iterator& it, std::size_t index, std::size_t size)
+                : operations(&Rest::operations<Iterator>), index(index), size(size) {
+            construct(it, storage);
+        }
+
+        iterator(const iterator& other) : operations(other.operations), index(other.index), size(other.size) {
+            copy(other);
+        }
+
+        iterator& operator =(const iterator& other) {
+            if (this != &other) {
+                destroy();
+                operations = other.operations;
+                index = other.index;
+                size = other.size;
+                copy(other);
+            }
+            return *this;
+        }
+
+        ~iterator() {
+            destroy();
+        }
+
+        void copy(const iterator& other) {
+            if (operations != nullptr && operations->copy != nullptr) {
+                operations->copy(other.storage, storage);
+            } else {
+                std::memcpy(storage, other.storage, storage_size);
+            }
+        }
+
+        void destroy() {
+            if (operations != nullptr && operations->destroy != nullptr) {
+                operations->destroy(storage);
+            }
+        }
+
+        Result<T> operator *() const {
+            return operations->parse(storage, index);
+        }
+
+        iterator& operator ++() {
+            operations->increment(storage);
+            ++index;
+            return *this;
+        }
+
+        iterator operator ++(int) {
+            const iterator result(*this);
+            operator ++();
+            return result;
+        }
+
+        friend bool operator ==(const iterator& lhs, const iterator& rhs) {
+            return lhs.index == rhs.index;
+        }
+
+        friend bool operator ==(const iterator& it, std::default_sentinel_t) {
+            return it.index == it.size;
+        }
+    };
+
+    iterator first;
+
+    Rest() = default;
+
+    template <class Iterator>
+    Rest(const Iterator& it, std::size_t size, std::size_t offset = 0) : first(it, offset, offset + size) {}
+
+    iterator begin() const {
+        return first;
+    }
+
+    std::default_sentinel_t end() const {
+        return std::default_sentinel;
+    }
+
+    std::size_t size() const {
+        return first.size - first.index;
+    }
+
+    bool empty() const {
+        return first.index == first.size;
+    }
+};
+
+template <class T>
+using rest = Rest<T>;
+
+template <class T>
+struct IsRest : std::false_type {};
+
+template <class T>
+struct IsRest<Rest<T>> : std::true_type {};
+
+template <class T>
+inline constexpr bool is_rest_v = IsRest<T>::value;
+
+template <class F>
+inline constexpr bool is_variadic_v = [] {
+    if constexpr (arguments_number_v<F> == 0) {
+        return false;
+    } else {
+        return is_rest_v<argument_t<F, arguments_number_v<F> - 1>>;
+    }
+} ();
+
+template <class Iterator>
+using token_t = decltype(token_value(*std::declval<const Iterator&>()));
+
+template <class Range>
+using consumed_t = decltype(consume(std::declval<Range>()));
+
+template <class ... Args>
+using context_t = decltype(make_context(std::declval<std::remove_reference_t<Args>&>() ...));
+
+template <class Range>
+inline constexpr bool is_nothrow_input_v = [] {
+    using Iterator = std::ranges::iterator_t<Range>;
+    using Sentinel = std::ranges::sentinel_t<Range>;
+    using Token = token_t<Iterator>;
+    return std::is_nothrow_default_constructible_v<Iterator>
+        && std::is_nothrow_copy_constructible_v<Iterator>
+        && std::is_nothrow_copy_assignable_v<Iterator>
+        && std::is_nothrow_copy_constructible_v<Sentinel>
+        && (!std::is_convertible_v<Token, std::string_view> || std::is_nothrow_convertible_v<Token, std::string_view>)
+        && requires (Iterator& it, const Iterator& other, const Sentinel& last) {
+            { ++it } noexcept;
+            { *other } noexcept;
+            { error_token(*other) } noexcept;
+            { other == last } noexcept;
+            requires (!std::sized_sentinel_for<Iterator, Iterator> || noexcept(other - other));
+        };
+} ();
+
+template <class Arg, class Context>
+inline constexpr bool is_nothrow_hold_v = [] {
+    if constexpr (is_deferred_v<Arg>) {
+        using Iterator = decltype(std::remove_cvref_t<Arg>::token);
+        return is_nothrow_parse_v<resolved_t<Arg>, token_t<Iterator>, Context>;
+    } else {
+        return true;
+    }
+} ();
+
+template <class Parameter, class Token, class Context>
+inline constexpr bool is_nothrow_bind_v = binds_token_v<Parameter, Token>
+    || is_nothrow_parse_v<std::remove_cvref_t<Parameter>, Token, Context>;
+
+template <class Parameter, class Token>
+using bound_t = std::conditional_t<binds_token_v<Parameter, Token>, Token, std::remove_cvref_t<Parameter>>;
+
+template <class Value>
+inline constexpr bool is_nothrow_value_v = std::is_void_v<Value> || std::is_nothrow_move_constructible_v<Value>;
+
+template <class F, class Range, class ... Args>
+inline constexpr bool is_nothrow_call_v = [] {
+    using Context = context_t<Args ...>;
+    if constexpr (!(is_nothrow_hold_v<Args, Context> && ...)) {
+        return false;
+    } else if constexpr (std::is_invocable_v<const F&, Range, resolved_t<Args&&> ...>) {
+        return std::is_nothrow_invocable_v<const F&, Range, resolved_t<Args&&> ...>
+            && is_nothrow_value_v<std::invoke_result_t<const F&, Range, resolved_t<Args&&> ...>>;
+    } else {
+        using Iterator = std::ranges::iterator_t<Range>;
+        using Token = token_t<Iterator>;
+        constexpr bool variadic = is_variadic_v<F>;
+        constexpr std::size_t arity = arguments_number_v<F> - (variadic ? 1 : 0);
+        constexpr std::size_t given = std::min(sizeof ... (Args), arity);
+        constexpr auto tail = [] {
+            if constexpr (variadic) {
+                return static_cast<std::tuple<argument_t<F, arity>>*>(nullptr);
+            } else {
+                return static_cast<std::tuple<>*>(nullptr);
+            }
+        } ();
+        return [] <std::size_t ... i, class ... Variadic> (std::index_sequence<i ...>, std::tuple<Variadic ...>*) {
+            return (is_nothrow_bind_v<parameter_t<F, given + i>, Token, Context> && ...)
+                && std::is_nothrow_invocable_v<const F&, resolved_t<Args&&> ...,
+                                               bound_t<parameter_t<F, given + i>, Token> ..., Variadic ...>
+                && is_nothrow_value_v<std::invoke_result_t<const F&, resolved_t<Args&&> ...,
+                                                           bound_t<parameter_t<F, given + i>, Token> ..., Variadic ...>>;
+        } (std::make_index_sequence<arity - given>(), tail);
+    }
+} ();
+
+template <class F, class Range, class ... Args>
+struct IsNothrow : std::bool_constant<is_nothrow_call_v<F, Range, Args ...>> {};
+
+template <class Tag, class F, class Range, class ... Args>
+struct IsNothrow<Action<Tag, F>, Range, Args ...> : IsNothrow<F, Range, Args ...> {};
+
+template <class F, class Range, class ... Args>
+inline constexpr bool is_nothrow_v = IsNothrow<F, Range, Args ...>::value;
+
+template <class Action, class Iterator, std::size_t n, std::size_t ... i, class ... Args>
+inline auto call_with_tokens(const Action& action, const Iterator& first, const std::array<Iterator, n>& tokens,
+                             const Iterator& tail, std::size_t tail_size, std::index_sequence<i ...>,
+                             Args&& ... args) {
+    const auto context = make_context(args ...);
+    if constexpr (is_variadic_v<Action>) {
+        return call(
+            action,
+            hold(first, context, std::forward<Args>(args)) ...,
+            bind_at<parameter_t<Action, sizeof ... (Args) + i>>(token_value(*tokens[i]), i, context) ...,
+            argument_t<Action, arguments_number_v<Action> - 1>(tail, tail_size, n)
+        );
+    } else {
+        return call(
+            action,
+            hold(first, context, std::forward<Args>(args)) ...,
+            bind_at<parameter_t<Action, sizeof ... (Args) + i>>(token_value(*tokens[i]), i, context) ...
+        );
+    }
+}
+
 template <class Action, std::ranges::input_range Range, class ... Args>
-inline auto invoke(const Action& action, Range input, Args&& ... args) {
-    if constexpr (std::is_invocable_v<Action, Range, Args&& ...>) {
+inline auto invoke(const Action& action, Range input, Args&& ... args) noexcept(is_nothrow_v<Action, Range, Args ...>) {
+    const auto first = std::ranges::begin(input);
+    if constexpr (is_node_v<Action>) {
         using Value = decltype(action(input, std::forward<Args>(args) ...));
         return Result<Value>(action(input, std::forward<Args>(args) ...));
-    } else if constexpr (sizeof ... (Args) >= arguments_number_v<Action>) {
-        using Value = decltype(action(std::forward<Args>(args) ...));
-        if (!std::empty(input)) {
-            return Result<Value>(tl::make_unexpected(Errc::TooManyArguments));
-        }
-        return Result<Value>(action(std::forward<Args>(args) ...));
+    } else if constexpr (std::is_invocable_v<Action, Range, resolved_t<Args&&> ...>) {
+        const auto context = make_context(args ...);
+        return call(action, input, hold(first, context, std::forward<Args>(args)) ...);
     } else {
-        using Value = decltype(invoke(action, consume(input), std::forward<Args>(args) ..., *std::begin(input)));
-        if (std::empty(input)) {
-            return Result<Value>(tl::make_unexpected(Errc::NotEnoughInput));
+        using Iterator = std::ranges::iterator_t<Range>;
+        constexpr bool variadic = is_variadic_v<Action>;
+        constexpr std::size_t arity = arguments_number_v<Action> - (variadic ? 1 : 0);
+        constexpr std::size_t missing = arity - std::min(sizeof ... (Args), arity);
+        using Tokens = std::array<Iterator, missing>;
+        using Sequence = std::make_index_sequence<missing>;
+        using Value = decltype(call_with_tokens(action, first, std::declval<const Tokens&>(), first, 0, Sequence(),
+                                                std::forward<Args>(args) ...));
+        Tokens tokens {};
+        Iterator tail = first;
+        std::size_t tail_size = 0;
+        if constexpr (std::ranges::random_access_range<Range> && std::ranges::sized_range<Range>) {
+            const auto size = std::ranges::size(input);
+            if (size < missing) {
+                return Value(tl::make_unexpected(Error {Errc::NotEnoughInput, size}));
+            }
+            if (!variadic && size > missing) {
+                return Value(tl::make_unexpected(Error {Errc::TooManyArguments, missing, 0, error_token(first[missing])}));
+            }
+            for (std::size_t i = 0; i < missing; ++i) {
+                tokens[i] = first + i;
+            }
+            tail = first + missing;
+            tail_size = size - missing;
+        } else {
+            auto it = first;
+            const auto last = std::ranges::end(input);
+            for (std::size_t i = 0; i < missing; ++i) {
+                if (it == last) {
+                    return Value(tl::make_unexpected(Error {Errc::NotEnoughInput, i}));
+                }
+                tokens[i] = it;
+                ++it;
+            }
+            if constexpr (variadic) {
+                tail = it;
+                tail_size = static_cast<std::size_t>(std::ranges::distance(it, last));
+            } else if (it != last) {
+                return Value(tl::make_unexpected(Error {Errc::TooManyArguments, missing, 0, error_token(*it)}));
+            }
         }
-        return Result<Value>(invoke(action, consume(input), std::forward<Args>(args) ..., *std::begin(input)));
+        return call_with_tokens(action, first, tokens, tail, tail_size, Sequence(), std::forward<Args>(args) ...);
     }
 }
 
+template <class Action, class Sink>
+struct Continued {
+    const Action& action;
+    Sink& sink;
+
+    template <class ... Args>
+        requires std::is_invocable_v<const Action&, Args&& ...>
+    auto operator ()(Args&& ... args) const {
+        using Value = std::invoke_result_t<const Action&, Args&& ...>;
+        if constexpr (is_result_v<Value> && std::is_void_v<result_value_t<Value>>) {
+            return action(std::forward<Args>(args) ...).map([&] {
+                return sink();
+            });
+        } else if constexpr (is_result_v<Value>) {
+            return action(std::forward<Args>(args) ...).map([&] (auto&& value) {
+                return sink(std::forward<decltype(value)>(value));
+            });
+        } else if constexpr (is_emplace_v<Sink>) {
+            return sink.emplace([&] {
+                return action(std::forward<Args>(args) ...);
+            });
+        } else if constexpr (std::is_void_v<Value>) {
+            action(std::forward<Args>(args) ...);
+            return sink();
+        } else {
+            return sink(action(std::forward<Args>(args) ...));
+        }
+    }
+};
+
+template <class Action, class Sink>
+struct ArgumentsNumber<Continued<Action, Sink>> : ArgumentsNumber<Action> {};
+
+template <class Action, class Sink>
+struct ArgumentTypes<Continued<Action, Sink>> : ArgumentTypes<Action> {};
+
+template <class Action, class Sink, class Range, class ... Args>
+struct IsNothrow<Continued<Action, Sink>, Range, Args ...>
+    : std::bool_constant<is_emplace_v<Sink> && is_nothrow_v<Action, Range, Args ...>> {};
+
+template <class Sink, class Value>
+struct SinkCall {
+    using type = std::invoke_result_t<Sink&, Value>;
+};
+
+template <class Sink>
+struct SinkCall<Sink, void> {
+    using type = std::invoke_result_t<Sink&>;
+};
+
+template <class Node, class Sink>
+struct SinkResult : SinkCall<Sink, result_value_t<return_type_t<Node>>> {};
+
+template <class Tag, class F, class Sink>
+struct SinkResult<Action<Tag, F>, Sink> : SinkResult<F, Sink> {};
+
+template <class Node, class Sink>
+    requires (is_selector_v<Node> || is_argument_v<Node>)
+struct SinkResult<Node, Sink> {
+    using type = typename Node::template sink_result<Sink>;
+};
+
+template <class Node, class Sink>
+using sink_result_t = typename SinkResult<Node, Sink>::type;
+
+template <class Node>
+inline constexpr const Node& node_of(const Node& node) {
+    return node;
+}
+
+template <class Tag, class F>
+inline constexpr const F& node_of(const Action<Tag, F>& action) {
+    return action.f;
+}
+
+template <class Action, class Sink, std::ranges::input_range Range, class ... Args>
+inline auto continue_to(const Action& action, Sink& sink, Range input, Args&& ... args) {
+    if constexpr (is_node_v<Action>) {
+        return node_of(action).continue_with(input, sink, std::forward<Args>(args) ...);
+    } else {
+        return invoke(Continued<Action, Sink> {action, sink}, input, std::forward<Args>(args) ...);
+    }
+}
+
+template <class F, class ... Args>
+inline decltype(auto) with_sink(F&& f, Args&& ... args) {
+    static_assert(sizeof ... (Args) > 0, "dispatch requires a sink as the last argument");
+    auto forwarded = std::forward_as_tuple(std::forward<Args>(args) ...);
+    return [&] <std::size_t ... i> (std::index_sequence<i ...>) -> decltype(auto) {
+        return f(std::get<sizeof ... (Args) - 1>(forwarded), std::get<i>(std::move(forwarded)) ...);
+    } (std::make_index_sequence<sizeof ... (Args) - 1>());
+}
+
 template <class, class = std::void_t<>>
 struct HasName : std::false_type {};
 
@@ -205,75 +1238,312 @@ template <class T>
 inline constexpr bool has_name_v = HasName<T>::value;
 
 template <class ... Actions>
-struct Selector {
+inline constexpr std::size_t names_number_v = [] {
+    constexpr std::array<bool, sizeof ... (Actions)> named {has_name_v<Actions> ...};
+    std::size_t result = 0;
+    while (result < named.size() && named[result]) {
+        ++result;
+    }
+    return result;
+} ();
+
+template <class ... Actions>
+inline constexpr std::size_t branches_number_v = [] {
+    constexpr std::array<bool, sizeof ... (Actions)> named {has_name_v<Actions> ...};
+    std::size_t result = names_number_v<Actions ...>;
+    while (result < named.size() && !named[result]) {
+        ++result;
+    }
+    return result - names_number_v<Actions ...>;
+} ();
+
+template <class Sequence, class ... Actions>
+struct NamesPrefix;
+
+template <std::size_t ... i, class ... Actions>
+struct NamesPrefix<std::index_sequence<i ...>, Actions ...> {
+    using type = Names<std::tuple_element_t<i, std::tuple<Actions ...>> ...>;
+};
+
+template <class ... Actions>
+using names_t = typename NamesPrefix<std::make_index_sequence<names_number_v<Actions ...>>, Actions ...>::type;
+
+template <class T>
+struct BranchClasses {
+    static constexpr TokenClass value = TokenClass::Any;
+};
+
+template <class T>
+    requires is_argument_v<T>
+struct BranchClasses<T> {
+    static constexpr TokenClass value = token_classes_v<typename T::value_type>;
+};
+
+template <class T>
+inline constexpr TokenClass branch_classes_v = BranchClasses<T>::value;
+
+template <class Token>
+inline constexpr TokenClass token_class_of(const Token& token) {
+    if constexpr (std::is_convertible_v<decltype(token_value(token)), std::string_view>) {
+        return classify(token_value(token));
+    } else {
+        return TokenClass::Any;
+    }
+}
+
+struct DefaultPolicy {
+    template <class Names>
+    using match = AutoMatch<Names>;
+
+    using result = ExpectedResult;
+};
+
+struct PrefilterPolicy : DefaultPolicy {
+    template <class Names>
+    using match = PrefilterAutoMatch<Names>;
+};
+
+template <class Policy, class ... Actions>
+struct BasicSelector {
     using return_type = Result<distinct_t<result_value_t<return_type_t<Actions>> ...>>;
 
-    static constexpr MakeResult<return_type> make_result {};
+    using names = names_t<Actions ...>;
+
+    using match = typename Policy::template match<names>;
+
+    static constexpr std::size_t branches = branches_number_v<Actions ...>;
+
+    static constexpr std::size_t reachable = names::size + branches;
+
+    static constexpr std::size_t edges = branches > 1 ? reachable + 1 : names::size + 1;
+
+    using result_policy = result_policy_t<Policy>;
+
+    using result_type = typename result_policy::template type<result_value_t<return_type>>;
 
     const std::tuple<Actions ...> actions;
 
     template <class ... Ts>
-    constexpr explicit Selector(Ts&& ... actions) : actions(std::forward<Ts>(actions) ...) {}
+    constexpr explicit BasicSelector(Ts&& ... actions) : actions(std::forward<Ts>(actions) ...) {}
 
     template <class ... Args>
-    return_type operator ()(std::ranges::input_range auto input, Args&& ... args) const {
+    result_type operator ()(std::ranges::input_range auto input, Args&& ... args) const
+        noexcept(is_nothrow_v<BasicSelector, decltype(input), Args ...> && result_policy::nothrow) {
+        return result_policy::make([&] {
+            Emplace<return_type> emplace;
+            return continue_with(input, emplace, std::forward<Args>(args) ...);
+        });
+    }
+
+    template <class Sink>
+    using sink_result = std::common_type_t<sink_result_t<Actions, Sink> ...>;
+
+    template <class Sink>
+    using continued = Result<result_value_t<sink_result<Sink>>>;
+
+    template <class Sink, class ... Args>
+    continued<Sink> continue_with(std::ranges::input_range auto input, Sink& sink, Args&& ... args) const {
         if (std::empty(input)) {
             return tl::make_unexpected(Errc::NotEnoughInput);
         }
-        return find_action(input, [&] (std::ranges::input_range auto input, const auto& action) {
-            return invoke(action, input, std::forward<Args>(args) ...);
+        return find_action<continued<Sink>>(input, [&] (std::ranges::input_range auto input, const auto& action) {
+            return continue_to(action, sink, input, std::forward<Args>(args) ...);
+        });
+    }
+
+    template <class ... Args>
+    auto dispatch(std::ranges::input_range auto input, Args&& ... args) const {
+        return result_policy::make([&] {
+            return with_sink([&] (auto& sink, auto&& ... args) {
+                return continue_with(input, sink, std::forward<decltype(args)>(args) ...);
+            }, std::forward<Args>(args) ...);
         });
     }
 
-    template <std::size_t i = 0, class F>
-    return_type find_action(std::ranges::input_range auto input, F&& f) const {
-        if constexpr (i >= std::tuple_size_v<decltype(actions)>) {
-            return tl::make_unexpected(Errc::InvalidAction);
-        } else if constexpr (has_name_v<std::tuple_element_t<i, decltype(actions)>>) {
-            if (std::get<i>(actions).name == *std::begin(input)) {
-                return make_result(f(consume(input), std::get<i>(actions)));
+    template <class Return = return_type, class F>
+    Return find_action(std::ranges::input_range auto input, F&& f) const {
+        using Input = decltype(input);
+        static constexpr auto calls = [] <std::size_t ... i> (std::index_sequence<i ...>) {
+            return std::array {&call_action<Return, i, Input, F> ...};
+        } (std::make_index_sequence<edges>());
+        if constexpr (edges == 1) {
+            return calls[0](*this, input, f);
+        } else {
+            return calls[select(*std::begin(input))](*this, input, f);
+        }
+    }
+
+    template <class Token>
+    static constexpr std::size_t select(const Token& token) {
+        std::size_t index = 0;
+        if constexpr (names::size > 0) {
+            index = match::find(token);
+        }
+        if constexpr (branches > 1) {
+            if (index == names::size) {
+                index += branch_of(token_class_of(token));
             }
-            return find_action<i + 1>(input, std::forward<F>(f));
+        }
+        return index;
+    }
+
+    static constexpr std::size_t branch_of(TokenClass classes) {
+        constexpr auto masks = [] <std::size_t ... i> (std::index_sequence<i ...>) {
+            return std::array {branch_classes_v<std::tuple_element_t<names::size + i, std::tuple<Actions ...>>> ...};
+        } (std::make_index_sequence<branches>());
+        return static_cast<std::size_t>(std::ranges::find_if(masks, [&] (TokenClass mask) {
+            return (mask & classes) != TokenClass::None;
+        }) - masks.begin());
+    }
+
+    template <class Return, std::size_t i, class Input, class F>
+    static Return call_action(const BasicSelector& self, Input input, F& f) {
+        if constexpr (i >= reachable) {
+            return tl::make_unexpected(Error {Errc::InvalidAction, 0, 0, error_token(*std::begin(input))});
         } else {
-            return make_result(f(input, std::get<i>(actions)));
+            return call_child<Return, i>(self, input, f);
+        }
+    }
+
+    template <class Return, std::size_t i, class Input, class F>
+    static Return call_child(const BasicSelector& self, Input input, F& f) {
+        constexpr bool named = i < names::size;
+        Return result = Emplace<Return>().emplace([&] {
+            if constexpr (named) {
+                return f(consume(input), std::get<i>(self.actions));
+            } else {
+                return f(input, std::get<i>(self.actions));
+            }
+        });
+        if (!result) {
+            result.error().index += named;
+            ++result.error().depth;
         }
+        return result;
     }
 };
 
+template <class ... Actions>
+struct Selector : BasicSelector<DefaultPolicy, Actions ...> {
+    using BasicSelector<DefaultPolicy, Actions ...>::BasicSelector;
+};
+
 template <class ... Actions>
 Selector(Actions&& ...) -> Selector<std::decay_t<Actions> ...>;
 
-template <class Tag, class ... Actions>
-struct ReturnType<Selector<Tag, Actions ...>> {
-    using type = typename Selector<Tag, Actions ...>::return_type;
+template <class Policy, class ... Actions>
+inline constexpr auto selector(Actions&& ... actions) {
+    return BasicSelector<Policy, std::decay_t<Actions> ...>(std::forward<Actions>(actions) ...);
+}
+
+template <class Policy, class ... Actions>
+struct ReturnType<BasicSelector<Policy, Actions ...>> {
+    using type = typename BasicSelector<Policy, Actions ...>::return_type;
 };
 
-template <class T, class ... Actions>
-struct Argument {
-    Selector<Actions ...> selector;
+template <class ... Actions>
+struct ReturnType<Selector<Actions ...>> : ReturnType<BasicSelector<DefaultPolicy, Actions ...>> {};
+
+template <class Policy, class ... Actions, class Range, class ... Args>
+struct IsNothrow<BasicSelector<Policy, Actions ...>, Range, Args ...> : std::bool_constant<is_nothrow_input_v<Range> && [] {
+    using Node = BasicSelector<Policy, Actions ...>;
+    return [] <std::size_t ... i> (std::index_sequence<i ...>) {
+        return (is_nothrow_v<Actions, std::conditional_t<(i < Node::names::size), consumed_t<Range>, Range>, Args ...>
+            && ...);
+    } (std::index_sequence_for<Actions ...>());
+} ()> {};
+
+template <class ... Actions, class Range, class ... Args>
+struct IsNothrow<Selector<Actions ...>, Range, Args ...> : IsNothrow<BasicSelector<DefaultPolicy, Actions ...>, Range, Args ...> {};
+
+template <class Policy, class T, class ... Actions>
+struct BasicArgument {
+    using value_type = T;
+
+    using selector_type = BasicSelector<Policy, Actions ...>;
+
+    using return_type = typename selector_type::return_type;
+
+    selector_type selector;
 
     template <class ... F>
-    constexpr explicit Argument(F&& ... f) : selector(std::forward<F>(f) ...) {}
+    constexpr explicit BasicArgument(F&& ... f) : selector(std::forward<F>(f) ...) {}
 
     template <class ... Args>
-    auto operator ()(std::ranges::input_range auto input, Args&& ... args) const
-        -> typename Selector<Actions ...>::return_type {
+    return_type operator ()(std::ranges::input_range auto input, Args&& ... args) const
+        noexcept(is_nothrow_v<BasicArgument, decltype(input), Args ...>) {
+        Emplace<return_type> emplace;
+        return continue_with(input, emplace, std::forward<Args>(args) ...);
+    }
+
+    template <class Sink>
+    using sink_result = typename selector_type::template sink_result<Sink>;
+
+    template <class Sink>
+    using continued = Result<result_value_t<sink_result<Sink>>>;
+
+    template <class Sink, class ... Args>
+    continued<Sink> continue_with(std::ranges::input_range auto input, Sink& sink, Args&& ... args) const {
         if (std::empty(input)) {
             return tl::make_unexpected(Errc::NotEnoughInput);
         }
-        return selector(consume(input), std::forward<Args>(args) ..., T {*std::begin(input)});
+        return continue_nested(input, sink, std::forward<Args>(args) ...);
+    }
+
+    template <class Sink, class ... Args>
+    continued<Sink> continue_nested(std::ranges::input_range auto input, Sink& sink, Args&& ... args) const {
+        continued<Sink> result = selector.continue_with(consume(input), sink, std::forward<Args>(args) ...,
+                                                        defer<T>(std::ranges::begin(input)));
+        if (!result) {
+            ++result.error().index;
+        }
+        return result;
+    }
+
+    template <class ... Args>
+    auto dispatch(std::ranges::input_range auto input, Args&& ... args) const {
+        return with_sink([&] (auto& sink, auto&& ... args) {
+            return continue_with(input, sink, std::forward<decltype(args)>(args) ...);
+        }, std::forward<Args>(args) ...);
     }
 };
 
+template <class T, class ... Actions>
+struct Argument : BasicArgument<DefaultPolicy, T, Actions ...> {
+    using BasicArgument<DefaultPolicy, T, Actions ...>::BasicArgument;
+};
+
 template <class T, class ... Actions>
 inline constexpr auto argument(Actions&& ... actions) {
     return Argument<T, std::decay_t<Actions> ...>(std::forward<Actions>(actions) ...);
 }
 
+template <class T, class Policy, class ... Actions>
+inline constexpr auto argument(Actions&& ... actions) {
+    return BasicArgument<Policy, T, std::decay_t<Actions> ...>(std::forward<Actions>(actions) ...);
+}
+
+template <class Policy, class T, class ... Actions>
+struct ArgumentsNumber<BasicArgument<Policy, T, Actions ...>> : ArgumentsNumber<BasicSelector<Policy, Actions ...>> {};
+
 template <class T, class ... Actions>
-struct ArgumentsNumber<Argument<T, Actions ...>> : ArgumentsNumber<Selector<Actions ...>> {};
+struct ArgumentsNumber<Argument<T, Actions ...>> : ArgumentsNumber<BasicArgument<DefaultPolicy, T, Actions ...>> {};
+
+template <class Policy, class T, class ... Actions>
+struct ReturnType<BasicArgument<Policy, T, Actions ...>> {
+    using type = typename BasicArgument<Policy, T, Actions ...>::return_type;
+};
 
 template <class T, class ... Actions>
-struct ReturnType<Argument<T, Actions ...>> : ReturnType<Selector<Actions ...>> {};
+struct ReturnType<Argument<T, Actions ...>> : ReturnType<BasicArgument<DefaultPolicy, T, Actions ...>> {};
+
+template <class Policy, class T, class ... Actions, class Range, class ... Args>
+struct IsNothrow<BasicArgument<Policy, T, Actions ...>, Range, Args ...>
+    : IsNothrow<BasicSelector<Policy, Actions ...>, consumed_t<Range>, Args ...,
+                Deferred<T, std::ranges::iterator_t<Range>>> {};
+
+template <class T, class ... Actions, class Range, class ... Args>
+struct IsNothrow<Argument<T, Actions ...>, Range, Args ...>
+    : IsNothrow<BasicArgument<DefaultPolicy, T, Actions ...>, Range, Args ...> {};
 
 } // namespace router
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace router {
+
+inline constexpr std::uint64_t hash(std::string_view value) noexcept {
+    std::uint64_t result = 14695981039346656037ull ^ value.size();
+    for (const char c : value) {
+        result ^= static_cast<unsigned char>(c);
+        result *= 1099511628211ull;
+    }
+    return result;
+}
+
+inline constexpr std::uint64_t mix(std::uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdull;
+    value ^= value >> 33;
+    return value;
+}
+
+struct Token {
+    std::string_view value;
+    std::uint64_t fingerprint = hash({});
+
+    constexpr Token() = default;
+
+    constexpr explicit Token(std::string_view value) : value(value), fingerprint(hash(value)) {}
+
+    constexpr operator std::string_view() const noexcept {
+        return value;
+    }
+};
+
+inline constexpr std::uint64_t fingerprint(std::string_view value) {
+    return hash(value);
+}
+
+inline constexpr std::uint64_t fingerprint(const Token& token) {
+    return token.fingerprint;
+}
+
+template <class T>
+inline constexpr decltype(auto) token_value(T&& token) noexcept {
+    return std::forward<T>(token);
+}
+
+inline constexpr std::string_view token_value(const Token& token) noexcept {
+    return token.value;
+}
+
+template <std::input_iterator Iterator, std::sentinel_for<Iterator> Sentinel>
+struct TokenIterator {
+    static_assert(
+        std::is_lvalue_reference_v<std::iter_reference_t<Iterator>>
+            || std::is_same_v<std::remove_cv_t<std::iter_reference_t<Iterator>>, std::string_view>,
+        "Tokens must refer to storage that outlives the iterator"
+    );
+
+    using value_type = Token;
+    using difference_type = std::iter_difference_t<Iterator>;
+
+    Iterator current;
+    Sentinel last;
+    Token token;
+
+    constexpr TokenIterator() = default;
+
+    constexpr TokenIterator(Iterator current, Sentinel last) : current(std::move(current)), last(std::move(last)) {
+        load();
+    }
+
+    constexpr Token operator *() const noexcept {
+        return token;
+    }
+
+    constexpr TokenIterator& operator ++() noexcept(noexcept(++current) && noexcept(load())) {
+        ++current;
+        load();
+        return *this;
+    }
+
+    constexpr TokenIterator operator ++(int) {
+        const TokenIterator result(*this);
+        operator ++();
+        return result;
+    }
+
+    constexpr void load()
+            noexcept(noexcept(current != last) && std::is_nothrow_constructible_v<std::string_view, decltype(*current)>) {
+        if (current != last) {
+            token = Token(std::string_view(*current));
+        }
+    }
+
+    friend constexpr bool operator ==(const TokenIterator& lhs, const TokenIterator& rhs)
+            noexcept(noexcept(lhs.current == rhs.current)) {
+        return lhs.current == rhs.current;
+    }
+
+    friend constexpr bool operator ==(const TokenIterator& iterator, std::default_sentinel_t)
+            noexcept(noexcept(iterator.current == iterator.last)) {
+        return iterator.current == iterator.last;
+    }
+};
+
+template <std::ranges::input_range Range>
+    requires std::ranges::borrowed_range<Range>
+inline constexpr auto tokens(Range&& range) {
+    return std::ranges::subrange(
+        TokenIterator(std::ranges::begin(range), std::ranges::end(range)),
+        std::default_sentinel
+    );
+}
+
+} // namespace router
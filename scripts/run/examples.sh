@@ -6,5 +6,22 @@ fi
 
 ${SRC}/scripts/run/rpg/examples.sh
 examples/community_example
+examples/community_flat_example
+examples/community_tokens_example
+examples/community_dispatch_example
 examples/int_if_then_example
 examples/int_router_example
+examples/void_leaf_example
+examples/community_no_exceptions_example
+examples/int_router_no_exceptions_example
+examples/rest_example
+examples/one_of_example
+examples/pattern_example
+examples/continuation_example
+examples/result_policies_example
+examples/result_policies_no_exceptions_example
+if [[ -x examples/result_policies_cxx23_example ]]; then
+    examples/result_policies_cxx23_example
+fi
+examples/profile_example
+examples/lookup_example
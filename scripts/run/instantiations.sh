@@ -0,0 +1,30 @@
+#!/bin/bash -e
+
+if [[ -z "${SRC}" ]]; then
+    export SRC=$(cd "$(dirname "$0")/../.." && pwd)
+fi
+
+object=$(mktemp)
+trap 'rm -f "${object}"' EXIT
+
+start=$(date +%s%N)
+${CXX:-c++} -std=c++20 -O0 -c -I"${SRC}/include" "$@" "${SRC}/benchmarks/instantiations.cpp" -o "${object}"
+end=$(date +%s%N)
+
+functions=$(nm -C --defined-only "${object}" | grep ' [tTwW] ')
+mangled=$(nm --defined-only "${object}" | grep ' [tTwW] ')
+
+count() {
+    echo "${functions}" | grep -c "$1" || true
+}
+
+count_mangled() {
+    echo "${mangled}" | grep -c "$1" || true
+}
+
+echo "router::invoke          $(count 'router::invoke<')"
+echo "find_action             $(count_mangled 'E11find_action')"
+echo "call_action             $(count_mangled 'E11call_action')"
+echo "router functions        $(count 'router::')"
+echo "all functions           $(echo "${functions}" | wc -l)"
+echo "compile milliseconds    $(( (end - start) / 1000000 ))"
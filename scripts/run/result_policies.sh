@@ -0,0 +1,30 @@
+#!/bin/bash -e
+
+if [[ -z "${SRC}" ]]; then
+    export SRC=$(cd "$(dirname "$0")/../.." && pwd)
+fi
+
+object=$(mktemp)
+trap 'rm -f "${object}"' EXIT
+
+${CXX:-c++} -std=c++23 -O2 -c -I"${SRC}/include" "$@" "${SRC}/benchmarks/result_policies.cpp" -o "${object}"
+
+symbols=$(nm -C -S --defined-only "${object}" | grep ' [tTwW] ')
+
+report() {
+    local symbol=$(nm --defined-only "${object}" | grep " T .*$1" | awk '{print $3}')
+    if [[ -z "${symbol}" ]]; then
+        return
+    fi
+    local instructions=$(objdump -d --no-show-raw-insn --disassemble="${symbol}" "${object}" | grep -c '^ *[0-9a-f]*:' || true)
+    local bytes=0
+    for size in $(echo "${symbols}" | grep -e " $1(" -e "router::$2" | awk '{print $2}'); do
+        bytes=$(( bytes + 16#${size} ))
+    done
+    printf '%-24s %6s entry instructions %8s text bytes\n' "$1" "${instructions}" "${bytes}"
+}
+
+report dispatch_expected ExpectedResult
+report dispatch_std_expected StdExpectedResult
+report dispatch_throwing ThrowingResult
+echo "object bytes             $(stat -c %s "${object}")"